@@ -0,0 +1,165 @@
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <cstdint>
+
+#ifdef __LINUX__
+#define FIXTURE_MODULE_API extern "C" __attribute__((visibility("default")))
+#else
+#define FIXTURE_MODULE_API extern "C" __declspec(dllexport)
+#endif
+
+#if !defined(LOCALIZATION_STRESS_KEYS) && !defined(LOCALIZATION_OVERLAY_REGION) && !defined(LOCALIZATION_OVERLAY_TENANT)
+#error Define LOCALIZATION_STRESS_KEYS, LOCALIZATION_OVERLAY_REGION or LOCALIZATION_OVERLAY_TENANT to select fixture dictionaries
+#endif
+
+namespace
+{
+	/// @brief Fixture module dictionaries. Exported functions are the same as in modules built by LocalizationUtils
+	/// @details Every language contains every key, untranslated values are empty strings like in generated modules
+	struct Dictionaries
+	{
+		std::vector<std::string> languages;
+		std::unordered_map<std::string, std::unordered_map<std::string, std::string>> values;
+
+		Dictionaries();
+	};
+
+	Dictionaries::Dictionaries()
+	{
+#if defined(LOCALIZATION_STRESS_KEYS)
+		// Key i is key.<i>, its value is <language>:<i>. Every 7th key is untranslated in de, so lookups fall back to original en
+		languages = { "en", "ru", "de" };
+
+		for (const std::string& language : languages)
+		{
+			std::unordered_map<std::string, std::string>& dictionary = values[language];
+
+			dictionary.reserve(LOCALIZATION_STRESS_KEYS);
+
+			for (size_t i = 0; i < LOCALIZATION_STRESS_KEYS; i++)
+			{
+				dictionary.try_emplace("key." + std::to_string(i), language != "de" || i % 7 ? language + ':' + std::to_string(i) : std::string());
+			}
+		}
+#elif defined(LOCALIZATION_OVERLAY_TENANT)
+		// Overrides first in en and second in ru
+		languages = { "en", "ru" };
+		values =
+		{
+			{ "en", { { "first", "Tenant first" } } },
+			{ "ru", { { "second", "Tenant second" } } }
+		};
+#else
+		// Overrides first and second in en, leaves first untranslated in ru and decimal separator untranslated in en
+		languages = { "en", "ru" };
+		values =
+		{
+			{ "en", { { "first", "Region first" }, { "second", "Region second" }, { "locale.decimalSeparator", "" } } },
+			{ "ru", { { "first", "" } } }
+		};
+#endif
+
+		std::vector<std::string> keys;
+
+		for (const auto& [language, dictionary] : values)
+		{
+			for (const auto& [key, value] : dictionary)
+			{
+				keys.push_back(key);
+			}
+		}
+
+		for (const std::string& language : languages)
+		{
+			for (const std::string& key : keys)
+			{
+				values[language].try_emplace(key);
+			}
+		}
+	}
+
+	const Dictionaries& getDictionaries()
+	{
+		static const Dictionaries dictionaries;
+
+		return dictionaries;
+	}
+}
+
+FIXTURE_MODULE_API const char* getLocalizedString(const char* key, const char* language)
+{
+	const Dictionaries& dictionaries = getDictionaries();
+	auto languageIterator = dictionaries.values.find(language);
+
+	if (languageIterator == dictionaries.values.end())
+	{
+		return nullptr;
+	}
+
+	auto it = languageIterator->second.find(key);
+
+	return it == languageIterator->second.end() ? nullptr : it->second.data();
+}
+
+FIXTURE_MODULE_API const char* getOriginalLanguage()
+{
+	return getDictionaries().languages.front().data();
+}
+
+FIXTURE_MODULE_API bool findLanguage(const char* language)
+{
+	return getDictionaries().values.contains(language);
+}
+
+FIXTURE_MODULE_API const char** getDictionariesLanguages(uint64_t* size)
+{
+	const std::vector<std::string>& languages = getDictionaries().languages;
+	const char** result = new const char* [languages.size()];
+
+	std::transform(languages.begin(), languages.end(), result, [](const std::string& language) { return language.data(); });
+
+	*size = languages.size();
+
+	return result;
+}
+
+FIXTURE_MODULE_API void freeDictionariesLanguages(const char** dictionariesLanguages)
+{
+	delete[] dictionariesLanguages;
+}
+
+FIXTURE_MODULE_API const char* getDictionary(const char* language, uint64_t* size, const char*** keys, const char*** values)
+{
+	const Dictionaries& dictionaries = getDictionaries();
+	auto languageIterator = dictionaries.values.find(language);
+
+	*size = 0;
+	*keys = nullptr;
+	*values = nullptr;
+
+	if (languageIterator == dictionaries.values.end())
+	{
+		return nullptr;
+	}
+
+	*keys = new const char* [languageIterator->second.size()];
+	*values = new const char* [languageIterator->second.size()];
+
+	for (const auto& [key, value] : languageIterator->second)
+	{
+		(*keys)[*size] = key.data();
+		(*values)[*size] = value.data();
+
+		(*size)++;
+	}
+
+	return languageIterator->first.data();
+}
+
+FIXTURE_MODULE_API void freeDictionary(const char** keys, const char** values)
+{
+	delete[] keys;
+	delete[] values;
+}
@@ -1,9 +1,28 @@
+#include <iostream>
 #include <fstream>
 #include <sstream>
+#include <filesystem>
+#include <thread>
+#include <latch>
+
+#ifdef __LINUX__
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
 
 #include "gtest/gtest.h"
 
 #include "MultiLocalizationManager.h"
+#include "DictionaryImage.h"
+#include "LocalizationLookup.h"
+#include "LookupTracer.h"
+#include "ModuleArena.h"
+#include "UsageProfile.h"
+#include "ReverseIndex.h"
+#include "NumaReplicas.h"
+#ifdef __LINUX__
+#include "SharedDictionary.h"
+#endif
 
 std::string getFirst()
 {
@@ -15,6 +34,64 @@ std::string getSecond()
 	return (std::ostringstream() << std::ifstream("second.txt", std::ios::binary).rdbuf()).str();
 }
 
+/// @brief Copy of default module that tests add under other names. Created before any test, so tests can run alone or shuffled
+class OverrideModule : public ::testing::Environment
+{
+public:
+	void SetUp() override
+	{
+#ifdef __LINUX__
+		std::filesystem::copy_file("libLocalizationData.so", "libOverride.so", std::filesystem::copy_options::overwrite_existing);
+#else
+		std::filesystem::copy_file("LocalizationData.dll", "Override.dll", std::filesystem::copy_options::overwrite_existing);
+#endif
+	}
+};
+
+const ::testing::Environment* const overrideModule = ::testing::AddGlobalTestEnvironment(new OverrideModule());
+
+// Must be first test, default module is loaded by concurrent callers
+TEST(Localization, ConcurrentInitialization)
+{
+	constexpr size_t threadsCount = 8;
+	std::latch start(threadsCount);
+	std::vector<std::thread> threads;
+	std::vector<localization::TextLocalization*> modules(threadsCount);
+	std::vector<localization::MultiLocalizationManager*> managers(threadsCount);
+
+	for (size_t i = 0; i < threadsCount; i++)
+	{
+		threads.emplace_back
+		(
+			[&start, &modules, &managers, i]()
+			{
+				start.arrive_and_wait();
+
+				modules[i] = &localization::TextLocalization::get();
+				managers[i] = &localization::MultiLocalizationManager::getManager();
+			}
+		);
+	}
+
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+
+	for (size_t i = 0; i < threadsCount; i++)
+	{
+		ASSERT_EQ(modules[i], &localization::TextLocalization::getInitialized());
+		ASSERT_EQ(managers[i], managers.front());
+	}
+
+	ASSERT_EQ(&localization::TextLocalization::initialize(), modules.front());
+	ASSERT_EQ(localization::TextLocalization::getInitialized().getString("first", "en"), "First");
+
+#ifndef __LINUX__
+	ASSERT_EQ(&localization::WTextLocalization::get(), &localization::WTextLocalization::getInitialized());
+#endif
+}
+
 TEST(Localization, TextLocalization)
 {
 	localization::TextLocalization& localization = localization::TextLocalization::get();
@@ -39,8 +116,640 @@ TEST(Localization, MultiLocalizationManager)
 	ASSERT_EQ(manager.getLocalizedString("LocalizationData", "second", "ru"), getSecond());
 }
 
+TEST(Localization, Overlays)
+{
+	localization::MultiLocalizationManager& manager = localization::MultiLocalizationManager::getManager();
+
+	manager.addModule("Region", "LocalizationRegion");
+	manager.addModule("Tenant", "LocalizationTenant");
+
+	manager.addOverlay("Region", "LocalizationData");
+	manager.addOverlay("Tenant", "Region");
+
+	ASSERT_THROW(manager.addOverlay("Region", "Tenant"), std::runtime_error);
+
+	char buffer[32];
+
+	ASSERT_EQ(manager.getLocaleData("Region", "en").formatDecimal(buffer, 1234.5), "1,234.50");
+
+	localization::LocalizedValue value = manager.getLocalizedValue("Tenant", "first", "en");
+
+	ASSERT_EQ(value.value, "Tenant first");
+	ASSERT_EQ(value.module, "Tenant");
+
+	value = manager.getLocalizedValue("Tenant", "second", "en");
+
+	ASSERT_EQ(value.value, "Region second");
+	ASSERT_EQ(value.module, "Region");
+
+	value = manager.getLocalizedValue("Tenant", "first", "ru");
+
+	ASSERT_EQ(value.value, getFirst());
+	ASSERT_EQ(value.module, "LocalizationData");
+
+	ASSERT_EQ(manager.getLocalizedString("Tenant", "second", "ru"), "Tenant second");
+	ASSERT_EQ(manager.getLocalizedString("Region", "first", "en"), "Region first");
+	ASSERT_EQ(manager.getModule("Tenant")->overlay->getLayers().size(), 3);
+
+	ASSERT_TRUE(manager.removeModule("Region"));
+
+	value = manager.getLocalizedValue("Tenant", "second", "en");
+
+	ASSERT_EQ(value.value, "Second");
+	ASSERT_EQ(value.module, "LocalizationData");
+	ASSERT_EQ(manager.getModule("Tenant")->overlay->getLayers().size(), 2);
+
+	manager.addModule("Region", "LocalizationRegion");
+
+	ASSERT_EQ(manager.getModule("Tenant")->overlay->getLayers().size(), 3);
+	ASSERT_EQ(manager.getLocalizedValue("Tenant", "second", "en").module, "Region");
+	ASSERT_EQ(manager.getLocalizedValue("Region", "first", "ru").module, "LocalizationData");
+	ASSERT_EQ(manager.getLocalizedString("Region", "first", "ru"), getFirst());
+
+	ASSERT_TRUE(manager.removeOverlay("Tenant"));
+	ASSERT_FALSE(manager.removeOverlay("Tenant"));
+
+	ASSERT_EQ(manager.getModule("Tenant")->overlay, nullptr);
+	ASSERT_TRUE(manager.getLocalizedString("Tenant", "second", "en").empty());
+	ASSERT_THROW(manager.getLocalizedString("Tenant", "third", "en"), std::runtime_error);
+
+	manager.removeOverlay("Region");
+	manager.removeModule("Tenant");
+	manager.removeModule("Region");
+}
+
+TEST(Localization, Formatting)
+{
+	using namespace std::chrono_literals;
+
+	localization::MultiLocalizationManager& manager = localization::MultiLocalizationManager::getManager();
+	const localization::LocaleData& en = manager.getLocaleData("LocalizationData", "en");
+	const localization::LocaleData& ru = localization::TextLocalization::get().getLocaleData("ru");
+	char buffer[64];
+
+	ASSERT_EQ(en.formatInteger(buffer, -1234567), "-1,234,567");
+	ASSERT_EQ(en.formatInteger(buffer, 999), "999");
+	ASSERT_EQ(en.formatDecimal(buffer, 1234567.891), "1,234,567.89");
+	ASSERT_EQ(en.formatDecimal(buffer, -0.001), "0.00");
+	ASSERT_EQ(en.formatCurrency(buffer, -1234.5, "$"), "-$1,234.50");
+	ASSERT_EQ(en.formatDate(buffer, 2024y / 3 / 7), "03/07/2024");
+	ASSERT_EQ(en.formatTime(buffer, 15h + 4min), "3:04 PM");
+
+	ASSERT_EQ(ru.formatInteger(buffer, 1234567), "1\xC2\xA0" "234\xC2\xA0" "567");
+	ASSERT_EQ(ru.formatDecimal(buffer, 1234.5, 1), "1\xC2\xA0" "234,5");
+	ASSERT_EQ(ru.formatCurrency(buffer, 1234.5, "\xE2\x82\xBD"), "1\xC2\xA0" "234,50\xC2\xA0\xE2\x82\xBD");
+	ASSERT_EQ(ru.formatDate(buffer, 2024y / 3 / 7), "07.03.2024");
+	ASSERT_EQ(ru.formatTime(buffer, 15h + 4min), "15:04");
+
+	ASSERT_TRUE(en.formatInteger(std::span<char>(buffer, 4), 12345).empty());
+}
+
+TEST(Localization, LookupTracer)
+{
+	localization::MultiLocalizationManager& manager = localization::MultiLocalizationManager::getManager();
+
+	localization::LookupTracer::start("trace.bin");
+
+	std::thread
+	(
+		[&manager]()
+		{
+			manager.getLocalizedString("LocalizationData", "first", "en");
+		}
+	).join();
+
+	manager.getLocalizedString("LocalizationData", "second", "unknown");
+
+	ASSERT_THROW(manager.getLocalizedString("LocalizationData", "unknown", "ru"), std::runtime_error);
+	ASSERT_THROW(manager.getLocalizedString("LocalizationData", std::string(localization::LookupTracer::maxKeySize + 1, 'k'), "en"), std::runtime_error);
+
+	ASSERT_EQ(localization::LookupTracer::stop(), 0);
+	ASSERT_FALSE(localization::LookupTracer::isEnabled());
+
+	localization::LookupTrace trace = localization::LookupTrace::load("trace.bin");
+
+	ASSERT_EQ(trace.records.size(), 4);
+
+	ASSERT_EQ(trace.records[0].result, localization::LookupResult::hit);
+	ASSERT_EQ(trace.records[1].result, localization::LookupResult::fallback);
+	ASSERT_EQ(trace.records[2].result, localization::LookupResult::miss);
+
+	ASSERT_NE(trace.records[0].thread, trace.records[1].thread);
+	ASSERT_EQ(trace.records[1].thread, trace.records[2].thread);
+	ASSERT_LE(trace.records[0].timestamp, trace.records[1].timestamp);
+
+	ASSERT_EQ(trace.strings[trace.records[0].module], "LocalizationData");
+	ASSERT_EQ(trace.strings[trace.records[1].language], "unknown");
+	ASSERT_EQ(trace.strings[trace.records[2].key], "unknown");
+
+	ASSERT_FALSE(trace.records[2].truncated);
+	ASSERT_TRUE(trace.records[3].truncated);
+	ASSERT_EQ(trace.strings[trace.records[3].key].size(), localization::LookupTracer::maxKeySize);
+}
+
+TEST(Localization, ProbeStatistics)
+{
+	std::vector<std::byte> data = localization::DictionaryImage::build(localization::TextLocalization::get());
+	localization::DictionaryImage image(data.data());
+	localization::DictionaryImage::ProbeStatistics statistics = image.getProbeStatistics("en");
+
+	ASSERT_EQ(statistics.keys, 2);
+	ASSERT_GE(statistics.capacity, statistics.keys * 2);
+	ASSERT_GE(statistics.averageProbeLength, 1.0);
+	ASSERT_LE(statistics.maxProbeLength, statistics.keys);
+	ASSERT_THROW(image.getProbeStatistics("unknown"), std::runtime_error);
+}
+
+TEST(Localization, ReverseIndex)
+{
+	using Keys = std::vector<std::string_view>;
+
+	localization::MultiLocalizationManager& manager = localization::MultiLocalizationManager::getManager();
+
+	ASSERT_EQ(manager.getReverseIndex("LocalizationData"), nullptr);
+
+	manager.buildReverseIndex("LocalizationData");
+
+	std::shared_ptr<const localization::ReverseIndex> index = manager.getReverseIndex("LocalizationData");
+
+	ASSERT_NE(index, nullptr);
+	ASSERT_GT(index->getMemoryUsage(), 0);
+
+	ASSERT_EQ(index->find("econ", "en"), Keys({ "second" }));
+	ASSERT_TRUE(index->find("SECOND", "en").empty());
+	ASSERT_EQ(index->find("SECOND", "en", true), Keys({ "second" }));
+	ASSERT_EQ(index->find("ir"), Keys({ "first" }));
+	ASSERT_EQ(index->find("\xD0\x92\xD0\xA2\xD0\x9E\xD0\xA0", "", true), Keys({ "second" }));
+	ASSERT_TRUE(index->find("Fourth").empty());
+	ASSERT_THROW(index->find("First", "unknown"), std::runtime_error);
+
+	ASSERT_EQ(localization::utility::foldCase("\xD0\x81\xD0\x96 \xCE\xA9 \xC3\x80Z"), "\xD1\x91\xD0\xB6 \xCF\x89 \xC3\xA0z");
+
+	ASSERT_TRUE(manager.dropReverseIndex("LocalizationData"));
+	ASSERT_FALSE(manager.dropReverseIndex("LocalizationData"));
+
+	manager.addModule("Indexed", "Override");
+	manager.buildReverseIndex("Indexed");
+
+	ASSERT_TRUE(manager.removeModule("Indexed"));
+	ASSERT_EQ(manager.getReverseIndex("Indexed"), nullptr);
+
+	manager.addModule("Indexed", "Override");
+
+	ASSERT_EQ(manager.getReverseIndex("Indexed")->find("econ", "en"), Keys({ "second" }));
+	ASSERT_TRUE(manager.dropReverseIndex("Indexed"));
+	ASSERT_TRUE(manager.removeModule("Indexed"));
+
+	manager.addModule("Indexed", "Override");
+
+	ASSERT_EQ(manager.getReverseIndex("Indexed"), nullptr);
+
+	manager.removeModule("Indexed");
+}
+
+TEST(Localization, KeyNormalization)
+{
+	localization::MultiLocalizationManager& manager = localization::MultiLocalizationManager::getManager();
+
+	ASSERT_TRUE(manager.setKeyNormalization("LocalizationData", localization::KeyNormalization::all).empty());
+
+	ASSERT_EQ(manager.getLocalizedString("LocalizationData", "FIRST", "en"), "First");
+	ASSERT_EQ(manager.getLocalizedString("LocalizationData", "Se_Cond", "ru"), getSecond());
+	ASSERT_EQ(manager.getLocalizedValue("LocalizationData", "first.", "ru").value, getFirst());
+
+	manager.addModule("Normalized", "Override");
+	manager.setKeyNormalization("Normalized", localization::KeyNormalization::foldCase);
+
+	ASSERT_EQ(manager.getLocalizedString("Normalized", "Second", "en"), "Second");
+	ASSERT_THROW(manager.getLocalizedString("Normalized", "sec-ond", "en"), std::runtime_error);
+
+	manager.removeModule("Normalized");
+	manager.addModule("Normalized", "Override");
+
+	ASSERT_EQ(manager.getLocalizedString("Normalized", "FIRST", "en"), "First");
+	ASSERT_TRUE(manager.getKeyAmbiguities("Normalized").empty());
+
+	manager.setKeyNormalization("Normalized", localization::KeyNormalization::none);
+	manager.setKeyNormalization("LocalizationData", localization::KeyNormalization::none);
+
+	ASSERT_THROW(manager.getLocalizedString("Normalized", "FIRST", "en"), std::runtime_error);
+	ASSERT_THROW(manager.getLocalizedString("LocalizationData", "FIRST", "en"), std::runtime_error);
+
+	manager.removeModule("Normalized");
+}
+
+TEST(Localization, ModuleArena)
+{
+	localization::MultiLocalizationManager& manager = localization::MultiLocalizationManager::getManager();
+	localization::ModuleArena arena;
+
+	{
+		std::pmr::vector<std::pmr::string> strings(&arena);
+
+		for (size_t i = 0; i < 1000; i++)
+		{
+			strings.emplace_back(std::string(64, 'a') + std::to_string(i));
+		}
+
+		ASSERT_EQ(std::string_view(strings.back()), std::string(64, 'a') + "999");
+		ASSERT_EQ(reinterpret_cast<uintptr_t>(arena.allocate(1, 64)) % 64, 0);
+	}
+
+	localization::ModuleArena::Statistics statistics = arena.getStatistics();
+
+	// Chunks grow from single page
+	ASSERT_GT(statistics.chunks, 1);
+	ASSERT_GE(statistics.reservedBytes, statistics.usedBytes);
+	ASSERT_LT(statistics.reservedBytes, 2 * statistics.usedBytes + 4 * 4096);
+	ASSERT_GT(statistics.usedBytes, 1000 * 64);
+
+	// Large allocation gets own chunk and next small allocation uses previous chunk
+	ASSERT_NE(arena.allocate(4 * 1024 * 1024, 8), nullptr);
+
+	ASSERT_EQ(arena.getStatistics().chunks, statistics.chunks + 1);
+
+	ASSERT_NE(arena.allocate(8, 8), nullptr);
+
+	ASSERT_EQ(arena.getStatistics().chunks, statistics.chunks + 1);
+
+	arena.release();
+
+	ASSERT_EQ(arena.getStatistics().chunks, 0);
+	ASSERT_EQ(arena.getStatistics().reservedBytes, 0);
+
+	localization::ModuleArena::Options previousOptions = manager.getArenaOptions();
+
+	manager.setArenaOptions({ localization::ArenaPages::explicitHuge, true });
+
+	localization::Holder* holder = manager.addModule("Arena", "Override");
+
+	manager.addOverlay("Arena", "LocalizationData");
+	manager.setKeyNormalization("Arena", localization::KeyNormalization::all);
+
+	statistics = holder->arena->getStatistics();
+
+	size_t normalizedKeysBytes = holder->normalizedKeysArena->getStatistics().usedBytes;
+
+	ASSERT_EQ(holder->arena->getOptions().pages, localization::ArenaPages::explicitHuge);
+	ASSERT_EQ(holder->overlayArena->getOptions().pages, localization::ArenaPages::explicitHuge);
+	// Holder is smaller than huge page, so it takes single normal page
+	ASSERT_LE(statistics.reservedBytes, 64 * 1024);
+	ASSERT_EQ(statistics.hugePagesBytes, 0);
+	ASSERT_GE(statistics.usedBytes, sizeof(localization::Holder));
+	ASSERT_GT(holder->overlayArena->getStatistics().usedBytes, 0);
+	ASSERT_GT(normalizedKeysBytes, 0);
+	ASSERT_EQ(manager.getLocalizedString("Arena", "FIRST", "en"), "First");
+	ASSERT_EQ(manager.getLocalizedString("Arena", "second", "ru"), getSecond());
+
+	// Rebuilt index replaces its arena, module arena doesn't grow
+	manager.setKeyNormalization("Arena", localization::KeyNormalization::all);
+
+	ASSERT_EQ(holder->normalizedKeysArena->getStatistics().usedBytes, normalizedKeysBytes);
+	ASSERT_EQ(holder->arena->getStatistics().usedBytes, statistics.usedBytes);
+
+	manager.setKeyNormalization("Arena", localization::KeyNormalization::none);
+	manager.removeOverlay("Arena");
+	manager.setArenaOptions(previousOptions);
+
+	ASSERT_TRUE(manager.removeModule("Arena"));
+}
+
+TEST(Localization, NumaReplicas)
+{
+	localization::MultiLocalizationManager& manager = localization::MultiLocalizationManager::getManager();
+	std::filesystem::path pathToNodes = std::filesystem::temp_directory_path() / "localization_numa_tests";
+
+	std::filesystem::create_directories(pathToNodes / "node0");
+	std::filesystem::create_directories(pathToNodes / "node2");
+
+	std::ofstream(pathToNodes / "online") << "0,2" << std::endl;
+	std::ofstream(pathToNodes / "node0" / "cpulist") << "0-1,4" << std::endl;
+	std::ofstream(pathToNodes / "node2" / "cpulist") << "2-3" << std::endl;
+
+	localization::NumaTopology topology = localization::NumaTopology::read(pathToNodes);
+
+	ASSERT_EQ(topology.getNodes(), std::vector<uint32_t>({ 0, 2 }));
+	ASSERT_EQ(topology.getNodeIndex(4), 0);
+	ASSERT_EQ(topology.getNodeIndex(3), 1);
+	ASSERT_EQ(topology.getNodeIndex(100), 0);
+	ASSERT_EQ(localization::NumaTopology::read(pathToNodes / "unknown").getNodesCount(), 1);
+
+	localization::NumaReplicas replicas(localization::TextLocalization::get(), topology, localization::ModuleArena::Options());
+
+	ASSERT_EQ(replicas.getReplicasCount(), 2);
+	ASSERT_NE(replicas.getImage(0).getData(), replicas.getImage(1).getData());
+	ASSERT_EQ(replicas.getImage(1).getString("first", "ru"), getFirst());
+	ASSERT_EQ(replicas.getLocalImage().getString("second", "en"), "Second");
+
+	std::filesystem::remove_all(pathToNodes);
+
+	ASSERT_EQ(manager.enableNumaReplicas("LocalizationData"), localization::NumaTopology::get().getNodesCount());
+	ASSERT_EQ(manager.getLocalizedString("LocalizationData", "first", "ru"), getFirst());
+	ASSERT_EQ(manager.getLocalizedValue("LocalizationData", "second", "en").value, "Second");
+	ASSERT_THROW(manager.getLocalizedString("LocalizationData", "unknown", "ru"), std::runtime_error);
+
+	manager.addModule("Replicated", "Override");
+	manager.enableNumaReplicas("Replicated");
+	manager.removeModule("Replicated");
+
+	ASSERT_NE(manager.addModule("Replicated", "Override")->replicas, nullptr);
+
+	std::string_view replicated = manager.getLocalizedString("Replicated", "second", "en");
+
+	ASSERT_EQ(replicated, "Second");
+	ASSERT_TRUE(manager.disableNumaReplicas("Replicated"));
+
+	// Copies stay valid until release and are reused
+	ASSERT_EQ(replicated, "Second");
+
+	manager.enableNumaReplicas("Replicated");
+
+	ASSERT_EQ(manager.getLocalizedString("Replicated", "second", "en").data(), replicated.data());
+	ASSERT_EQ(manager.getModule("Replicated")->builtReplicas.size(), 1);
+
+	ASSERT_TRUE(manager.disableNumaReplicas("Replicated"));
+	ASSERT_TRUE(manager.disableNumaReplicas("LocalizationData"));
+	ASSERT_FALSE(manager.disableNumaReplicas("LocalizationData"));
+	ASSERT_EQ(manager.getModule("Replicated")->builtReplicas.size(), 1);
+
+	ASSERT_GT(manager.releaseRetired(), 0);
+	ASSERT_TRUE(manager.getModule("Replicated")->builtReplicas.empty());
+	ASSERT_EQ(manager.releaseRetired(), 0);
+
+	manager.removeModule("Replicated");
+}
+
+TEST(Localization, UsageProfile)
+{
+	localization::MultiLocalizationManager& manager = localization::MultiLocalizationManager::getManager();
+	std::filesystem::path pathToProfile = std::filesystem::temp_directory_path() / "localization_usage_tests.txt";
+
+	manager.addModule("Used", "Override");
+	manager.startUsageRecording();
+
+	ASSERT_EQ(manager.getLocalizedString("LocalizationData", "first", "ru"), getFirst());
+	ASSERT_EQ(manager.getLocalizedValue("Used", "second", "en").value, "Second");
+	ASSERT_THROW(manager.getLocalizedString("Used", "unknown", "en"), std::runtime_error);
+
+	manager.stopUsageRecording().save(pathToProfile);
+
+	localization::UsageProfile profile = localization::UsageProfile::load(pathToProfile);
+	std::optional<localization::UsageProfile::Module> used = profile.getModule("Used");
+
+	std::filesystem::remove(pathToProfile);
+
+	ASSERT_EQ(profile.size(), 2);
+	ASSERT_TRUE(profile.getModule("LocalizationData")->isKeyAllowed("ru", "first"));
+	ASSERT_TRUE(used->isKeyAllowed("en", "second"));
+	ASSERT_FALSE(used->isKeyAllowed("en", "first"));
+	ASSERT_FALSE(used->hasLanguage("ru"));
+
+	ASSERT_TRUE(manager.getRecordedUsage().empty());
+
+	using Keys = std::vector<std::string_view>;
+
+	manager.buildReverseIndex("Used");
+	manager.setUsageProfile(profile);
+
+	// Module data can't be pruned, so keys that weren't recorded are still found in module
+	ASSERT_EQ(manager.getModule("Used")->replicas, nullptr);
+	ASSERT_EQ(manager.getLocalizedString("Used", "second", "en"), "Second");
+	ASSERT_EQ(manager.getLocalizedString("Used", "first", "en"), "First");
+	ASSERT_EQ(manager.getLocalizedString("Used", "second", "ru"), getSecond());
+	ASSERT_EQ(manager.getLocalizedString("LocalizationData", "second", "en"), "Second");
+	ASSERT_THROW(manager.getLocalizedString("Used", "unknown", "en"), std::runtime_error);
+	ASSERT_TRUE(manager.getReverseIndex("Used")->find("irst", "en").empty());
+	ASSERT_TRUE(manager.getReverseIndex("Used")->find("", "ru").empty());
+	ASSERT_EQ(manager.getReverseIndex("Used")->find("econ", "en"), Keys({ "second" }));
+
+	manager.enableNumaReplicas("Used");
+
+	const localization::NumaReplicas* replicas = manager.getModule("Used")->replicas;
+
+	ASSERT_TRUE(replicas->isPruned());
+	ASSERT_EQ(replicas->getLocalImage().find("first", "en"), nullptr);
+	ASSERT_EQ(manager.getLocalizedValue("Used", "second", "en").value, "Second");
+	ASSERT_EQ(manager.getLocalizedString("Used", "first", "en"), "First");
+	ASSERT_FALSE(manager.getLocalizedValue("Used", "first", "ru").fallback);
+	ASSERT_EQ(manager.getLocalizedString("Used", "first", "ru"), getFirst());
+
+	manager.setKeyNormalization("Used", localization::KeyNormalization::foldCase);
+
+	ASSERT_EQ(manager.getLocalizedString("Used", "SECOND", "en"), "Second");
+	ASSERT_EQ(manager.getLocalizedString("Used", "FIRST", "en"), "First");
+
+	manager.addModule("UsedRegion", "LocalizationRegion");
+	manager.addOverlay("UsedRegion", "Used");
+
+	// Values of restricted layer aren't in merged table
+	ASSERT_EQ(manager.getLocalizedValue("UsedRegion", "second", "ru").module, "Used");
+	ASSERT_EQ(manager.getLocalizedString("UsedRegion", "second", "ru"), getSecond());
+	ASSERT_EQ(manager.getLocalizedString("UsedRegion", "first", "ru"), getFirst());
+	ASSERT_EQ(manager.getLocalizedValue("UsedRegion", "first", "en").module, "UsedRegion");
+
+	profile.addLanguage(localization::UsageProfile::anyModule, "ru");
+
+	ASSERT_TRUE(profile.getModule("Other")->isKeyAllowed("ru", "second"));
+
+	manager.setUsageProfile(profile);
+
+	ASSERT_NE(manager.getModule("Used")->replicas, replicas);
+	ASSERT_NE(manager.getModule("Used")->replicas->getLocalImage().find("second", "ru"), nullptr);
+	ASSERT_EQ(manager.getLocalizedString("Used", "second", "ru"), getSecond());
+	ASSERT_EQ(manager.getLocalizedString("UsedRegion", "second", "ru"), getSecond());
+
+	manager.setUsageProfile(localization::UsageProfile());
+
+	ASSERT_FALSE(manager.getModule("Used")->replicas->isPruned());
+	ASSERT_EQ(manager.getReverseIndex("Used")->find("irst", "en"), Keys({ "first" }));
+
+	manager.disableNumaReplicas("Used");
+	manager.setKeyNormalization("Used", localization::KeyNormalization::none);
+	manager.dropReverseIndex("Used");
+
+	ASSERT_GT(manager.releaseRetired(), 0);
+
+	manager.removeOverlay("UsedRegion");
+	manager.removeModule("UsedRegion");
+	manager.removeModule("Used");
+}
+
+TEST(Localization, MessageCache)
+{
+	localization::MultiLocalizationManager& manager = localization::MultiLocalizationManager::getManager();
+
+	manager.enableMessageCache(64, 2);
+
+	std::shared_ptr<const std::string> first = manager.getRenderedString("LocalizationData", "first", "en", 1, "admin");
+
+	ASSERT_EQ(*first, "First");
+	ASSERT_EQ(manager.getRenderedString("LocalizationData", "first", "en", 1, "admin"), first);
+	ASSERT_NE(manager.getRenderedString("LocalizationData", "first", "en", 2, "admin"), first);
+
+	auto hashArguments = [](const auto&... args)
+		{
+			const localization::MessageArgument arguments[] = { localization::MessageArgument(args)... };
+
+			return localization::MessageCache::hashArguments(arguments);
+		};
+
+	ASSERT_NE(hashArguments('a'), hashArguments(97));
+	ASSERT_NE(hashArguments(true), hashArguments(1));
+	ASSERT_NE(hashArguments(-1), hashArguments(UINT64_MAX));
+	ASSERT_NE(hashArguments(0.0), hashArguments(-0.0));
+	ASSERT_EQ(hashArguments(short(1), "admin"), hashArguments(1, std::string("admin")));
+
+	manager.addModule("Cached", "Override");
+
+	std::shared_ptr<const std::string> cached = manager.getRenderedString("Cached", "second", "ru");
+
+	ASSERT_EQ(manager.getMessageCacheStatistics().entries, 3);
+
+	manager.removeModule("Cached");
+
+	localization::MessageCache::Statistics statistics = manager.getMessageCacheStatistics();
+
+	ASSERT_EQ(*cached, getSecond());
+	ASSERT_EQ(statistics.entries, 2);
+	ASSERT_EQ(statistics.hits, 1);
+	ASSERT_EQ(statistics.misses, 3);
+	ASSERT_GT(statistics.memoryUsage, 0);
+
+	localization::MessageCache cache(2, 1);
+
+	for (int i = 0; i < 3; i++)
+	{
+		cache.insert("Module", "en", "key", i, "value", cache.getEpoch("Module"));
+	}
+
+	ASSERT_EQ(cache.getStatistics().entries, 2);
+	ASSERT_EQ(cache.getStatistics().evictions, 1);
+	ASSERT_EQ(cache.find("Module", "en", "key", 0), nullptr);
+	ASSERT_EQ(*cache.find("Module", "en", "key", 2), "value");
+
+	uint64_t epoch = cache.getEpoch("Module");
+
+	cache.invalidate("Module");
+
+	ASSERT_EQ(*cache.insert("Module", "en", "key", 3, "stale", epoch), "stale");
+	ASSERT_EQ(cache.find("Module", "en", "key", 3), nullptr);
+
+	manager.startUsageRecording();
+
+	ASSERT_EQ(manager.getRenderedString("LocalizationData", "first", "en", 1, "admin"), first);
+	ASSERT_TRUE(manager.stopUsageRecording().getModule("LocalizationData")->isKeyAllowed("en", "first"));
+
+	manager.disableMessageCache();
+
+	ASSERT_EQ(manager.getMessageCacheStatistics().entries, 0);
+}
+
+TEST(Localization, LookupHandle)
+{
+	localization::LookupHandle handle = localization::getLookupHandle();
+
+	ASSERT_TRUE(handle);
+	ASSERT_STREQ(handle.find("first", "en"), "First");
+	ASSERT_EQ(handle.find("unknown", "en"), nullptr);
+	ASSERT_EQ(handle.getString("second", "ru"), getSecond());
+	ASSERT_EQ(handle.getOriginalLanguage(), "en");
+	ASSERT_EQ(localization::getLocalizedString("LocalizationData", "second", "en"), "Second");
+
+	ASSERT_FALSE(localization::LookupHandle());
+	ASSERT_EQ(localization::LookupHandle().find("first", "en"), nullptr);
+	ASSERT_THROW(localization::getLookupHandle("unknown"), std::runtime_error);
+}
+
+#ifdef __LINUX__
+/// @brief Segment name passed to worker process of SharedDictionary test
+constexpr const char* sharedWorkerEnvironmentVariable = "LOCALIZATION_TESTS_SEGMENT";
+
+/// @brief Worker process of SharedDictionary test. Attaches module without settings file
+int runSharedWorker(const char* segmentName) try
+{
+	std::string first = getFirst();
+	std::filesystem::path pathToWorker = std::filesystem::temp_directory_path() / "localization_shared_worker";
+
+	std::filesystem::create_directories(pathToWorker);
+	std::filesystem::current_path(pathToWorker);
+
+	localization::SharedDictionary dictionary(segmentName);
+	localization::MultiLocalizationManager& manager = localization::MultiLocalizationManager::getSharedManager();
+
+	manager.attachSharedModule("Worker", segmentName);
+
+	return dictionary.getString("first", "ru") == first &&
+		manager.getDefaultModuleName().empty() &&
+		manager.getLocalizedString("Worker", "first", "ru") == first &&
+		manager.getLocalizedString("Worker", "second") == "Second" ? 0 : 1;
+}
+catch (const std::exception& e)
+{
+	std::cerr << e.what() << std::endl;
+
+	return 2;
+}
+
+TEST(Localization, SharedDictionary)
+{
+	localization::MultiLocalizationManager& manager = localization::MultiLocalizationManager::getManager();
+	constexpr std::string_view segmentName = "/localization_tests";
+
+	uint64_t generation = manager.publishSharedModule("LocalizationData", segmentName);
+
+	pid_t worker = fork();
+
+	if (!worker)
+	{
+		// New process image has no manager, so worker creates it with getSharedManager
+		setenv(sharedWorkerEnvironmentVariable, segmentName.data(), 1);
+
+		execl("/proc/self/exe", "Tests", nullptr);
+
+		_exit(127);
+	}
+
+	int status = 0;
+
+	ASSERT_EQ(waitpid(worker, &status, 0), worker);
+	ASSERT_TRUE(WIFEXITED(status));
+	ASSERT_EQ(WEXITSTATUS(status), 0);
+
+	manager.attachSharedModule("Shared", segmentName);
+
+	ASSERT_EQ(manager.getLocalizedString("Shared", "second", "ru"), getSecond());
+	ASSERT_EQ(manager.getLocalizedString("Shared", "first"), "First");
+	ASSERT_THROW(manager.getLocalizedString("Shared", "unknown", "ru"), std::runtime_error);
+	ASSERT_THROW(manager.addModule("Shared", "Override"), std::runtime_error);
+
+	std::string_view previous = manager.getLocalizedString("Shared", "first", "ru");
+
+	ASSERT_EQ(manager.publishSharedModule("LocalizationData", segmentName), generation + 1);
+	ASSERT_EQ(manager.refreshSharedModules(), 1);
+	ASSERT_EQ(manager.getLocalizedString("Shared", "first", "ru"), getFirst());
+
+	// Previous generation stays mapped until release
+	ASSERT_EQ(previous, getFirst());
+
+	previous = manager.getLocalizedString("Shared", "second", "ru");
+
+	ASSERT_TRUE(manager.detachSharedModule("Shared"));
+	ASSERT_EQ(previous, getSecond());
+	ASSERT_GT(manager.releaseRetired(), 0);
+	ASSERT_TRUE(localization::SharedDictionary::remove(segmentName));
+	ASSERT_THROW(localization::SharedDictionary dictionary(segmentName), std::runtime_error);
+}
+#endif
+
 int main(int argc, char** argv)
 {
+#ifdef __LINUX__
+	if (const char* segmentName = std::getenv(sharedWorkerEnvironmentVariable))
+	{
+		return runSharedWorker(segmentName);
+	}
+#endif
+
 	testing::InitGoogleTest(&argc, argv);
 
 	return RUN_ALL_TESTS();
@@ -0,0 +1,335 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <latch>
+#include <mutex>
+#include <chrono>
+#include <algorithm>
+
+#include "MultiLocalizationManager.h"
+
+#ifndef LOCALIZATION_STRESS_KEYS
+#define LOCALIZATION_STRESS_KEYS 4096
+#endif
+
+/// @brief Generated module used as default module
+constexpr std::string_view defaultModuleName = "LocalizationStressData";
+/// @brief The same generated module used by stable modules and modules added and removed during run
+constexpr std::string_view moduleName = "LocalizationStressModule";
+constexpr std::string_view languages[] = { "en", "ru", "de" };
+/// @brief Lookups between checks of stop flag
+constexpr size_t batchSize = 256;
+/// @brief Batches between add/read/remove cycles of thread own module
+constexpr size_t churnPeriod = 16;
+constexpr size_t stableModulesCount = 4;
+
+std::mutex outputMutex;
+
+struct Expected
+{
+	std::vector<std::string> keys;
+	/// @brief Values for each language, missing de values fall back to en
+	std::vector<std::vector<std::string>> values;
+	/// @brief Default module followed by stable modules
+	std::vector<std::string> modules;
+};
+
+struct PhaseResult
+{
+	size_t threads;
+	uint64_t lookups;
+	uint64_t churns;
+	uint64_t failures;
+	double seconds;
+
+	double getPerThreadThroughput() const
+	{
+		return lookups / seconds / threads;
+	}
+};
+
+/// @brief Counters of each worker are on separate cache line
+class alignas(64) Worker
+{
+private:
+	localization::MultiLocalizationManager& manager;
+	const Expected& expected;
+	const std::atomic<bool>& stop;
+	std::string churnModuleName;
+	uint64_t state;
+
+public:
+	uint64_t lookups;
+	uint64_t churns;
+	uint64_t failures;
+
+private:
+	uint64_t next()
+	{
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+
+		return state;
+	}
+
+	void check(std::string_view localizationModuleName, size_t key, size_t language)
+	{
+		try
+		{
+			std::string_view value = manager.getLocalizedString(localizationModuleName, expected.keys[key], languages[language]);
+
+			if (value == expected.values[language][key])
+			{
+				return;
+			}
+
+			std::lock_guard<std::mutex> lock(outputMutex);
+
+			std::cerr << "Wrong value of " << expected.keys[key] << " for " << languages[language] << " in " << localizationModuleName << ": " << value << std::endl;
+		}
+		catch (const std::exception& e)
+		{
+			std::lock_guard<std::mutex> lock(outputMutex);
+
+			std::cerr << "Lookup of " << expected.keys[key] << " in " << localizationModuleName << " failed: " << e.what() << std::endl;
+		}
+
+		failures++;
+	}
+
+	void churn()
+	{
+		try
+		{
+			// Other threads keep reading stable module while its replicas are enabled and disabled
+			const std::string& replicatedModuleName = expected.modules[1 + churns % stableModulesCount];
+
+			manager.addModule(churnModuleName, std::string(moduleName));
+			manager.enableNumaReplicas(replicatedModuleName);
+
+			for (size_t i = 0; i < 8; i++)
+			{
+				uint64_t random = this->next();
+
+				this->check(churnModuleName, random % expected.keys.size(), (random >> 32) % std::size(languages));
+				this->check(replicatedModuleName, random % expected.keys.size(), (random >> 32) % std::size(languages));
+			}
+
+			manager.disableNumaReplicas(replicatedModuleName);
+
+			if (!manager.removeModule(churnModuleName))
+			{
+				std::lock_guard<std::mutex> lock(outputMutex);
+
+				std::cerr << "Can't remove " << churnModuleName << std::endl;
+
+				failures++;
+			}
+		}
+		catch (const std::exception& e)
+		{
+			std::lock_guard<std::mutex> lock(outputMutex);
+
+			std::cerr << "Churn of " << churnModuleName << " failed: " << e.what() << std::endl;
+
+			failures++;
+		}
+
+		churns++;
+	}
+
+public:
+	Worker(localization::MultiLocalizationManager& manager, const Expected& expected, const std::atomic<bool>& stop, size_t index) :
+		manager(manager),
+		expected(expected),
+		stop(stop),
+		churnModuleName("StressChurn" + std::to_string(index)),
+		state(0x9E3779B97F4A7C15ULL * (index + 1)),
+		lookups(0),
+		churns(0),
+		failures(0)
+	{
+
+	}
+
+	void run()
+	{
+		for (size_t batch = 1; !stop.load(std::memory_order_relaxed); batch++)
+		{
+			for (size_t i = 0; i < batchSize; i++)
+			{
+				uint64_t random = this->next();
+
+				this->check(expected.modules[(random >> 48) % expected.modules.size()], random % expected.keys.size(), (random >> 32) % std::size(languages));
+			}
+
+			lookups += batchSize;
+
+			if (!(batch % churnPeriod))
+			{
+				this->churn();
+			}
+		}
+	}
+};
+
+PhaseResult runPhase(localization::MultiLocalizationManager& manager, const Expected& expected, size_t threadsCount, std::chrono::milliseconds duration)
+{
+	std::atomic<bool> stop = false;
+	std::vector<Worker> workers;
+	std::vector<std::thread> threads;
+	std::latch ready(threadsCount + 1);
+
+	workers.reserve(threadsCount);
+
+	for (size_t i = 0; i < threadsCount; i++)
+	{
+		workers.emplace_back(manager, expected, stop, i);
+	}
+
+	for (Worker& worker : workers)
+	{
+		threads.emplace_back
+		(
+			[&worker, &ready]()
+			{
+				ready.arrive_and_wait();
+
+				worker.run();
+			}
+		);
+	}
+
+	ready.arrive_and_wait();
+
+	auto start = std::chrono::steady_clock::now();
+
+	std::this_thread::sleep_for(duration);
+
+	stop.store(true, std::memory_order_relaxed);
+
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+
+	PhaseResult result = { threadsCount, 0, 0, 0, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() };
+
+	for (const Worker& worker : workers)
+	{
+		result.lookups += worker.lookups;
+		result.churns += worker.churns;
+		result.failures += worker.failures;
+	}
+
+	return result;
+}
+
+/// @brief Mixed read/add/remove and replicas enable/disable workload at 1, 2, 4, 8 and hardware threads count
+/// @details Arguments: minimum per thread throughput at hardware threads count relative to single thread(0 disables check), phase duration in milliseconds.
+/// Returns non zero if any lookup returned wrong value or throughput check failed
+int main(int argc, char** argv) try
+{
+	double minimumScaling = argc > 1 ? std::stod(argv[1]) : 0.0;
+	std::chrono::milliseconds duration(argc > 2 ? std::stoull(argv[2]) : 500);
+	size_t hardwareThreads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+	std::vector<size_t> threadsCounts = { 1, 2, 4, 8, hardwareThreads };
+	localization::MultiLocalizationManager& manager = localization::MultiLocalizationManager::getManager();
+	Expected expected;
+
+	std::sort(threadsCounts.begin(), threadsCounts.end());
+
+	threadsCounts.erase(std::unique(threadsCounts.begin(), threadsCounts.end()), threadsCounts.end());
+
+	if (manager.getDefaultModuleName() != defaultModuleName)
+	{
+		std::cerr << "Default module must be " << defaultModuleName << ", check localization_modules.json" << std::endl;
+
+		return 1;
+	}
+
+	for (size_t i = 0; i < LOCALIZATION_STRESS_KEYS; i++)
+	{
+		expected.keys.push_back("key." + std::to_string(i));
+	}
+
+	for (std::string_view language : languages)
+	{
+		std::vector<std::string>& values = expected.values.emplace_back();
+
+		for (size_t i = 0; i < expected.keys.size(); i++)
+		{
+			values.push_back(std::string(language == "de" && !(i % 7) ? "en" : language) + ':' + std::to_string(i));
+		}
+	}
+
+	expected.modules.emplace_back(defaultModuleName);
+
+	for (size_t i = 0; i < stableModulesCount; i++)
+	{
+		std::string name = "StressStable" + std::to_string(i);
+
+		manager.addModule(name, std::string(moduleName));
+
+		expected.modules.push_back(std::move(name));
+	}
+
+	std::vector<PhaseResult> results;
+	uint64_t failures = 0;
+
+	std::cout << std::left << std::setw(10) << "threads"
+		<< std::right << std::setw(16) << "lookups/s"
+		<< std::setw(20) << "lookups/s/thread"
+		<< std::setw(10) << "scaling"
+		<< std::setw(10) << "churns" << std::endl;
+
+	for (size_t threadsCount : threadsCounts)
+	{
+		const PhaseResult& result = results.emplace_back(runPhase(manager, expected, threadsCount, duration));
+
+		// No lookup values are used between phases
+		manager.releaseRetired();
+
+		failures += result.failures;
+
+		std::cout << std::left << std::setw(10) << threadsCount
+			<< std::right << std::fixed << std::setprecision(0) << std::setw(16) << result.lookups / result.seconds
+			<< std::setw(20) << result.getPerThreadThroughput()
+			<< std::setprecision(3) << std::setw(10) << result.getPerThreadThroughput() / results.front().getPerThreadThroughput()
+			<< std::setw(10) << result.churns << std::endl;
+	}
+
+	for (size_t i = 0; i < stableModulesCount; i++)
+	{
+		manager.removeModule(expected.modules[i + 1]);
+	}
+
+	if (failures)
+	{
+		std::cerr << failures << " failed lookups" << std::endl;
+
+		return 1;
+	}
+
+	const PhaseResult& hardwareResult = *std::find_if(results.begin(), results.end(), [hardwareThreads](const PhaseResult& result) { return result.threads == hardwareThreads; });
+	double scaling = hardwareResult.getPerThreadThroughput() / results.front().getPerThreadThroughput();
+
+	if (scaling < minimumScaling)
+	{
+		std::cerr << "Per thread throughput at " << hardwareThreads << " threads is " << scaling << " of single thread, expected at least " << minimumScaling << std::endl;
+
+		return 1;
+	}
+
+	return 0;
+}
+catch (const std::exception& e)
+{
+	std::cerr << e.what() << std::endl;
+
+	return 1;
+}
@@ -0,0 +1,183 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <memory>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <unordered_map>
+#include <memory_resource>
+
+#ifdef __LINUX__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "ModuleArena.h"
+#include "StringViewUtils.h"
+
+using Dictionary = std::pmr::unordered_map<std::pmr::string, std::pmr::string, localization::utility::StringViewHash, localization::utility::StringViewEqual>;
+
+/// @brief dTLB load misses of calling thread. Unavailable without perf events access
+class TlbMissesCounter
+{
+private:
+	int descriptor;
+
+public:
+	TlbMissesCounter() :
+		descriptor(-1)
+	{
+#ifdef __LINUX__
+		perf_event_attr attributes = {};
+
+		attributes.type = PERF_TYPE_HW_CACHE;
+		attributes.size = sizeof(attributes);
+		attributes.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+		attributes.disabled = 1;
+		attributes.exclude_kernel = 1;
+		attributes.exclude_hv = 1;
+
+		descriptor = static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0));
+#endif
+	}
+
+	bool isAvailable() const
+	{
+		return descriptor != -1;
+	}
+
+	void start()
+	{
+#ifdef __LINUX__
+		if (this->isAvailable())
+		{
+			ioctl(descriptor, PERF_EVENT_IOC_RESET, 0);
+			ioctl(descriptor, PERF_EVENT_IOC_ENABLE, 0);
+		}
+#endif
+	}
+
+	uint64_t stop()
+	{
+		uint64_t result = 0;
+
+#ifdef __LINUX__
+		if (this->isAvailable())
+		{
+			ioctl(descriptor, PERF_EVENT_IOC_DISABLE, 0);
+
+			if (read(descriptor, &result, sizeof(result)) != sizeof(result))
+			{
+				result = 0;
+			}
+		}
+#endif
+
+		return result;
+	}
+
+	~TlbMissesCounter()
+	{
+#ifdef __LINUX__
+		if (this->isAvailable())
+		{
+			close(descriptor);
+		}
+#endif
+	}
+};
+
+/// @brief Build dictionary interleaved with unrelated heap allocations like long running process does and measure random lookups
+void run(std::string_view name, std::pmr::memory_resource* resource, const std::vector<std::string>& keys, const std::vector<size_t>& order)
+{
+	std::vector<std::unique_ptr<char[]>> noise;
+	std::mt19937_64 random(1);
+	Dictionary dictionary(resource);
+
+	dictionary.reserve(keys.size());
+
+	for (const std::string& key : keys)
+	{
+		dictionary.try_emplace(std::pmr::string(key, resource), std::pmr::string(std::string(32 + random() % 96, 'v'), resource));
+
+		noise.emplace_back(std::make_unique<char[]>(16 + random() % 256));
+	}
+
+	TlbMissesCounter counter;
+	size_t found = 0;
+
+	counter.start();
+
+	auto start = std::chrono::steady_clock::now();
+
+	for (size_t index : order)
+	{
+		auto it = dictionary.find(keys[index]);
+
+		found += it->second.size();
+	}
+
+	double nanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+	uint64_t misses = counter.stop();
+
+	std::cout << std::left << std::setw(24) << name
+		<< std::right << std::setw(12) << std::fixed << std::setprecision(1) << nanoseconds / order.size() << " ns/lookup";
+
+	if (counter.isAvailable())
+	{
+		std::cout << std::setw(14) << std::setprecision(3) << static_cast<double>(misses) / order.size() << " dTLB misses/lookup";
+	}
+	else
+	{
+		std::cout << std::setw(14) << "n/a" << " dTLB misses/lookup";
+	}
+
+	std::cout << " (" << found % 10 << ')' << std::endl;
+}
+
+void runArena(std::string_view name, const localization::ModuleArena::Options& options, const std::vector<std::string>& keys, const std::vector<size_t>& order)
+{
+	localization::ModuleArena arena(options);
+
+	run(name, &arena, keys, order);
+
+	localization::ModuleArena::Statistics statistics = arena.getStatistics();
+
+	std::cout << std::setw(24) << "" << std::right << std::setw(12) << statistics.reservedBytes / 1024 << " KB in " << statistics.chunks << " chunks, "
+		<< statistics.hugePagesBytes / 1024 << " KB huge pages, "
+		<< statistics.lockedBytes / 1024 << " KB locked" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+	size_t keysCount = argc > 1 ? std::stoull(argv[1]) : 100'000;
+	size_t lookupsCount = argc > 2 ? std::stoull(argv[2]) : 5'000'000;
+	std::mt19937_64 random(0);
+	std::vector<std::string> keys;
+	std::vector<size_t> order(lookupsCount);
+
+	keys.reserve(keysCount);
+
+	for (size_t i = 0; i < keysCount; i++)
+	{
+		keys.push_back("module.section" + std::to_string(i % 97) + ".key" + std::to_string(random()));
+	}
+
+	for (size_t& index : order)
+	{
+		index = random() % keysCount;
+	}
+
+	std::cout << keysCount << " keys, " << lookupsCount << " random lookups" << std::endl;
+
+	run("new/delete", std::pmr::new_delete_resource(), keys, order);
+	runArena("arena", { localization::ArenaPages::normal, false }, keys, order);
+	runArena("arena transparent huge", { localization::ArenaPages::transparentHuge, false }, keys, order);
+	runArena("arena explicit huge", { localization::ArenaPages::explicitHuge, true }, keys, order);
+
+	return 0;
+}
@@ -0,0 +1,61 @@
+# Usage: cmake -DCOMPILER=<path> -DCOMPILER_ID=<id> -DINCLUDE=<dir> -DBASELINE=<file> -DSOURCES=<file,file> -DBUDGETS=<bytes,bytes> -P HeaderBudget.cmake
+# Prints preprocessed size of each source. Fails if any source is bigger than BASELINE by more than its budget
+
+function(get_preprocessed_size source result)
+	if (COMPILER_ID STREQUAL "MSVC")
+		set(flags /nologo /EP /std:c++20 /I${INCLUDE})
+	else()
+		set(flags -E -P -std=c++20 -I${INCLUDE})
+	endif()
+
+	if (CMAKE_HOST_UNIX)
+		list(APPEND flags -D__LINUX__)
+	endif()
+
+	execute_process(
+		COMMAND ${COMPILER} ${flags} ${source}
+		OUTPUT_VARIABLE output
+		ERROR_VARIABLE errors
+		RESULT_VARIABLE code
+	)
+
+	if (NOT code EQUAL 0)
+		message(FATAL_ERROR "Can't preprocess ${source}: ${errors}")
+	endif()
+
+	string(LENGTH "${output}" size)
+
+	set(${result} ${size} PARENT_SCOPE)
+endfunction()
+
+get_preprocessed_size(${BASELINE} baselineSize)
+
+message(STATUS "${BASELINE}: ${baselineSize} bytes")
+
+string(REPLACE "," ";" SOURCES "${SOURCES}")
+string(REPLACE "," ";" BUDGETS "${BUDGETS}")
+list(LENGTH SOURCES sourcesCount)
+list(LENGTH BUDGETS budgetsCount)
+
+if (NOT sourcesCount EQUAL budgetsCount)
+	message(FATAL_ERROR "Got ${sourcesCount} sources and ${budgetsCount} budgets")
+endif()
+
+set(exceeded "")
+
+foreach(source budget IN ZIP_LISTS SOURCES BUDGETS)
+	get_preprocessed_size(${source} size)
+	math(EXPR difference "${size} - ${baselineSize}")
+
+	message(STATUS "${source}: ${size} bytes, +${difference} over baseline, budget ${budget}")
+
+	if (difference GREATER budget)
+		list(APPEND exceeded "${source} exceeds header budget of ${budget} bytes over baseline")
+	endif()
+endforeach()
+
+if (exceeded)
+	list(JOIN exceeded "\n" exceeded)
+
+	message(FATAL_ERROR "${exceeded}")
+endif()
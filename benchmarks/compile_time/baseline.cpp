@@ -0,0 +1,6 @@
+#include <string_view>
+
+std::string_view getBaseline(std::string_view key)
+{
+	return key;
+}
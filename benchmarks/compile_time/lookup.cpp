@@ -0,0 +1,11 @@
+#include "LocalizationLookup.h"
+
+std::string_view getLookup(const localization::LookupHandle& handle, std::string_view key)
+{
+	if (const char* result = handle.find(key, handle.getCurrentLanguage()))
+	{
+		return result;
+	}
+
+	return localization::getLocalizedString("", key);
+}
@@ -0,0 +1,6 @@
+#include "MultiLocalizationManager.h"
+
+std::string_view getManager(std::string_view key)
+{
+	return localization::MultiLocalizationManager::getManager().getLocalizedString("", key);
+}
@@ -0,0 +1,6 @@
+#include "TextLocalization.h"
+
+std::string_view getText(std::string_view key)
+{
+	return localization::TextLocalization::get()[key];
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+/// @file ArenaOptions.h
+/// @brief Options of ModuleArena without memory resource headers
+
+#include <cstddef>
+#include <cstdint>
+
+#include "LocalizationConstants.h"
+
+namespace localization
+{
+	/// @brief Pages that back ModuleArena chunks
+	enum class ArenaPages : uint8_t
+	{
+		normal,
+		/// @brief Chunks aligned to huge page size and advised for transparent huge pages. Linux only, normal pages on Windows
+		transparentHuge,
+		/// @brief Chunks from reserved huge pages pool(MAP_HUGETLB or MEM_LARGE_PAGES). Falls back to transparentHuge if pool is empty or privilege is missing
+		explicitHuge
+	};
+
+	/// @brief Pages, locking and chunk sizes of ModuleArena
+	struct LOCALIZATION_API ArenaOptions
+	{
+		/// @brief Pages of chunks not smaller than huge page. Smaller chunks use normal pages
+		ArenaPages pages = ArenaPages::normal;
+		/// @brief Lock chunks in RAM with mlock(VirtualLock on Windows). Failure is reported by ModuleArena::Statistics::lockedBytes
+		bool lock = false;
+		/// @brief Maximum size of growing chunks in bytes. Rounded up to page size. Larger allocations get their own chunk
+		size_t chunkSize = 2 * 1024 * 1024;
+		/// @brief Preferred NUMA node of chunks pages(mbind). Any node if negative. Linux only
+		int32_t node = -1;
+	};
+}
@@ -1,26 +1,18 @@
 #pragma once
 
+/// @file BaseTextLocalization.h
+/// @brief Declarations and inline singleton accessors. Loader is compiled into library, see src/TextLocalization.cpp
+
 #include <unordered_map>
 #include <string>
-#include <stdexcept>
-#include <format>
-#include <algorithm>
-#include <fstream>
+#include <vector>
+#include <memory>
+#include <atomic>
 #include <filesystem>
 
-#ifdef __LINUX__
-#include <dlfcn.h>
-#else
-#include <Windows.h>
-#endif
-
-#include <JsonParser.h>
-
 #include "LocalizationConstants.h"
-
-#ifdef __LINUX__
-using HMODULE = void*;
-#endif
+#include "LocaleData.h"
+#include "StringViewUtils.h"
 
 namespace localization
 {
@@ -32,6 +24,10 @@ namespace localization
 		using DictionariesFunction = const char* (*)(const char* key, const char* language);
 		using FindLanguageFunction = bool (*)(const char* language);
 		using OriginalLanguageFunction = const char* (*)();
+		using DictionariesLanguagesFunction = const char** (*)(uint64_t* size);
+		using FreeDictionariesLanguagesFunction = void (*)(const char** languages);
+		using DictionaryFunction = const char* (*)(const char* language, uint64_t* size, const char*** keys, const char*** values);
+		using FreeDictionaryFunction = void (*)(const char** keys, const char** values);
 
 	private:
 		DictionariesFunction dictionaries;
@@ -39,7 +35,21 @@ namespace localization
 		OriginalLanguageFunction originalLanguage;
 		std::string language;
 		std::filesystem::path pathToModule;
-		HMODULE handle;
+		std::unordered_map<std::string, LocaleData, utility::StringViewHash, utility::StringViewEqual> localeData;
+		/// @brief HMODULE on Windows, dlopen handle on Linux
+		void* handle;
+
+	private:
+		/// @brief Published by initialize after default module is completely loaded
+		static std::atomic<BaseTextLocalization<T>*> instance;
+
+	private:
+		void* loadFunction(const char* name) const;
+
+		/// @exception std::runtime_error Module doesn't export dictionaries functions
+		void loadDictionaryFunctions(DictionaryFunction& dictionaryFunction, FreeDictionaryFunction& freeDictionaryFunction) const;
+
+		void loadLocaleData();
 
 	private:
 		BaseTextLocalization(std::string_view localizationModule);
@@ -55,11 +65,21 @@ namespace localization
 		~BaseTextLocalization();
 
 	public:
-		/// @brief Exception can be thrown on first call. Warnings outputs in std::cerr
+		/// @brief Load default localization module once. Thread safe, concurrent callers wait until first call finishes. If loading throws next call tries again. Warnings outputs in std::cerr
+		/// @return Singleton instance of default localization module(Localization.dll)
+		/// @exception std::runtime_error Can't find localization module or something inside localization module
+		static BaseTextLocalization& initialize();
+
+		/// @brief Calls initialize on first use
 		/// @return Singleton instance of default localization module(Localization.dll)
 		/// @exception std::runtime_error Can't find localization module or something inside localization module
 		static BaseTextLocalization& get();
 
+		/// @brief Singleton instance without initialization check. Single load of published pointer
+		/// @return Singleton instance of default localization module(Localization.dll)
+		/// @warning initialize or get must successfully finish before
+		static BaseTextLocalization& getInitialized() noexcept;
+
 		/// @brief Change localization
 		/// @param language Language key
 		/// @exception std::runtime_error Wrong language
@@ -76,10 +96,38 @@ namespace localization
 		/// @brief Get path to used module
 		const std::filesystem::path& getPathToModule() const;
 
+		/// @brief Get all languages of module
+		/// @return Languages
+		/// @exception std::runtime_error Module doesn't export dictionaries functions
+		std::vector<std::string> getLanguages() const;
+
+		/// @brief Iterate over all non empty localized values of specific language
+		/// @param language Language key
+		/// @param callback Called with std::string_view key and std::basic_string_view<T> value. Both point to module memory and valid while module is loaded
+		/// @exception std::runtime_error Module doesn't export dictionaries functions
+		template<typename CallbackT>
+		void forEachString(std::string_view language, CallbackT&& callback) const;
+
+		/// @brief Get number, currency and date formatting data
+		/// @param language Specific language
+		/// @return LocaleData
+		/// @exception std::runtime_error Wrong language
+		const LocaleData& getLocaleData(std::string_view language) const;
+
+		/// @brief Get number, currency and date formatting data of current language
+		/// @return LocaleData
+		const LocaleData& getLocaleData() const;
+
+		/// @brief Find localized value without exceptions
+		/// @param key Null terminated localization key
+		/// @param language Null terminated language
+		/// @return Value in module memory or nullptr if key or language doesn't exist. Untranslated keys have empty value
+		const char* find(std::string_view key, std::string_view language) const noexcept;
+
 		/// @brief Get localized text
 		/// @param key Localization key
 		/// @param language Specific language
-		/// @param allowOriginal If can't find text for specific language try to find in original language
+		/// @param allowOriginal If can't find text for specific language or it is untranslated try to find in original language
 		/// @return Localized value
 		/// @exception std::runtime_error Wrong key
 		/// @exception std::out_of_range
@@ -93,171 +141,53 @@ namespace localization
 
 		friend class BaseTextLocalization<wchar_t>;
 		friend class MultiLocalizationManager;
+		friend class LookupHandle;
 		friend struct LocalizationHolder;
 		friend std::unique_ptr<BaseTextLocalization<T>>::deleter_type;
 	};
 
-	template<typename T>
-	BaseTextLocalization<T>::BaseTextLocalization(std::string_view localizationModule)
-	{
-#ifdef __LINUX__
-		pathToModule = std::format("lib{}.so", localizationModule);
-#else
-		pathToModule = std::format("{}.dll", localizationModule);
-#endif
-
-		if (!std::filesystem::exists(pathToModule))
-		{
-			throw std::runtime_error(std::format("Can't find {}", pathToModule.string()));
-		}
-
-#ifdef __LINUX__
-		handle = dlopen(pathToModule.string().data(), RTLD_LAZY);
-#else
-		handle = LoadLibraryA(pathToModule.string().data());
-#endif
-		auto load = [this](const char* name)
-			{
-#ifdef __LINUX__
-				return dlsym(handle, name);
-#else
-				return GetProcAddress(handle, name);
-#endif
-			};
-
-		if (!handle)
-		{
-			throw std::runtime_error(std::format("Can't load {}", pathToModule.string()));
-		}
-
-		dictionaries = reinterpret_cast<DictionariesFunction>(load("getLocalizedString"));
-
-		if (!dictionaries)
-		{
-			throw std::runtime_error(std::format("Can't find getLocalizedString function in {}, rebuild and try again", pathToModule.string()));
-		}
-
-		originalLanguage = reinterpret_cast<OriginalLanguageFunction>(load("getOriginalLanguage"));
-
-		if (!originalLanguage)
-		{
-			throw std::runtime_error(std::format("Can't find getOriginalLanguage function in {}, rebuild and try again", pathToModule.string()));
-		}
-
-		findLanguage = reinterpret_cast<FindLanguageFunction>(load("findLanguage"));
-
-		if (!findLanguage)
-		{
-			throw std::runtime_error(std::format("Can't find findLanguage function in {}, rebuild and try again", pathToModule.string()));
-		}
-
-		language = originalLanguage();
-	}
-
-	template<typename T>
-	BaseTextLocalization<T>::BaseTextLocalization(BaseTextLocalization<T>&& other) noexcept
-	{
-		(*this) = std::move(other);
-	}
-
-	template<typename T>
-	BaseTextLocalization<T>& BaseTextLocalization<T>::operator = (BaseTextLocalization<T>&& other) noexcept
-	{
-		dictionaries = other.dictionaries;
-		originalLanguage = other.originalLanguage;
-		language = std::move(other.language);
-		pathToModule = std::move(other.pathToModule);
-		handle = other.handle;
-
-		other.handle = nullptr;
-
-		return *this;
-	}
-
-	template<typename T>
-	BaseTextLocalization<T>::~BaseTextLocalization()
-	{
-#ifdef __LINUX__
-		dlclose(handle);
-#else
-		FreeLibrary(handle);
-#endif
-
-		handle = nullptr;
-	}
-
 	template<typename T>
 	inline BaseTextLocalization<T>& BaseTextLocalization<T>::get()
 	{
-		static std::unique_ptr<BaseTextLocalization<T>> instance;
-
-		if (!instance)
+		if (BaseTextLocalization<T>* result = instance.load(std::memory_order_acquire)) [[likely]]
 		{
-			json::JsonParser settings(std::ifstream(localizationModulesFile.data()));
-
-			instance = std::unique_ptr<BaseTextLocalization<T>>(new BaseTextLocalization<T>(settings.get<std::string>(settings::defaultModuleSetting)));
+			return *result;
 		}
 
-		return *instance;
+		return BaseTextLocalization<T>::initialize();
 	}
 
 	template<typename T>
-	void BaseTextLocalization<T>::changeLanguage(std::string_view language)
+	inline BaseTextLocalization<T>& BaseTextLocalization<T>::getInitialized() noexcept
 	{
-		if (!findLanguage(language.data()))
-		{
-			throw std::runtime_error(std::format(R"(Wrong language value "{}")", language));
-		}
-
-		this->language = language;
+		return *instance.load(std::memory_order_acquire);
 	}
 
 	template<typename T>
-	std::string_view BaseTextLocalization<T>::getOriginalLanguage() const
+	template<typename CallbackT>
+	void BaseTextLocalization<T>::forEachString(std::string_view language, CallbackT&& callback) const
 	{
-		return originalLanguage();
-	}
+		DictionaryFunction dictionaryFunction = nullptr;
+		FreeDictionaryFunction freeDictionaryFunction = nullptr;
 
-	template<typename T>
-	std::string_view BaseTextLocalization<T>::getCurrentLanguage() const
-	{
-		return language;
-	}
+		this->loadDictionaryFunctions(dictionaryFunction, freeDictionaryFunction);
 
-	template<typename T>
-	const std::filesystem::path& BaseTextLocalization<T>::getPathToModule() const
-	{
-		return pathToModule;
-	}
+		std::string languageKey(language);
+		uint64_t size = 0;
+		const char** keys = nullptr;
+		const char** values = nullptr;
 
-	template<typename T>
-	std::basic_string_view<T> BaseTextLocalization<T>::getString(std::string_view key, std::string_view language, bool allowOriginal) const
-	{
-		const char* result = dictionaries(key.data(), language.data());
+		dictionaryFunction(languageKey.data(), &size, &keys, &values);
 
-		if (!result)
+		for (uint64_t i = 0; i < size; i++)
 		{
-			if (!allowOriginal)
-			{
-				throw std::runtime_error(std::format(R"(Can't find key "{}" for {})", key, language));
-			}
-
-			std::string_view originalLanguageView = this->getOriginalLanguage();
-
-			result = dictionaries(key.data(), originalLanguageView.data());
-
-			if (!result)
+			// Resolve through getLocalizedString so value points to module memory rather than to temporary dictionary. Untranslated keys are empty
+			if (const char* value = dictionaries(keys[i], languageKey.data()); value && *value)
 			{
-				throw std::runtime_error(std::format(R"(Can't find key "{}" for {}, also can't find in original language {})", key, language, originalLanguageView));
+				callback(std::string_view(keys[i]), std::basic_string_view<T>(value));
 			}
 		}
 
-		return std::string_view(result);
-	}
-
-	template<typename T>
-	std::basic_string_view<T> BaseTextLocalization<T>::operator [] (std::string_view key) const
-	{
-		return this->getString(key, language);
+		freeDictionaryFunction(keys, values);
 	}
 }
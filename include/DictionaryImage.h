@@ -0,0 +1,116 @@
+#pragma once
+
+/// @file DictionaryImage.h
+/// @brief Decoded dictionaries of module in single position independent memory block
+
+#include <vector>
+#include <cstddef>
+
+#include "TextLocalization.h"
+#include "UsageProfile.h"
+
+namespace localization
+{
+	/// @brief Read only view of dictionaries image. Image contains only offsets so it can be mapped at any address, copied or shared between processes
+	/// @details Each language has open addressing hash table(stable FNV-1a hash, linear probing) over null terminated UTF-8 strings pool. Image size is limited by 4 GB
+	class LOCALIZATION_API DictionaryImage
+	{
+	public:
+		/// @brief Image format version
+		static constexpr uint32_t version = 1;
+		/// @brief Returned by findSlot if key doesn't exist
+		static constexpr size_t npos = static_cast<size_t>(-1);
+
+	public:
+		/// @brief Hash table quality of single language
+		struct LOCALIZATION_API ProbeStatistics
+		{
+			size_t keys;
+			size_t capacity;
+			/// @brief Average number of slots visited to find existing key
+			double averageProbeLength;
+			size_t maxProbeLength;
+			/// @brief Keys not placed in their home slot
+			size_t collisions;
+		};
+
+	private:
+		const std::byte* data;
+
+	public:
+		/// @brief Decode all languages of module into image
+		/// @param localization Source module
+		/// @param generation Generation number stored in image
+		/// @param usage Keep only allowed languages and keys. Original language is always kept with keys allowed in any language
+		/// @return Image bytes
+		/// @exception std::runtime_error Module doesn't export dictionaries functions or image is too big
+		static std::vector<std::byte> build(const TextLocalization& localization, uint64_t generation = 0, const UsageProfile::Module* usage = nullptr);
+
+		/// @brief Check that memory block contains image of supported version
+		/// @param data Start of image
+		/// @param size Size of memory block
+		static bool isValid(const void* data, size_t size);
+
+	public:
+		/// @brief Create view
+		/// @param data Start of image. Must be aligned to 8 bytes and valid while view is used
+		DictionaryImage(const void* data = nullptr);
+
+		DictionaryImage(const DictionaryImage&) = default;
+
+		DictionaryImage& operator = (const DictionaryImage&) = default;
+
+		/// @brief Get start of image
+		const void* getData() const;
+
+		/// @brief Get size of image in bytes
+		size_t getSize() const;
+
+		/// @brief Get generation number passed to build
+		uint64_t getGeneration() const;
+
+		/// @brief Get original language
+		std::string_view getOriginalLanguage() const;
+
+		/// @brief Get all languages of image
+		std::vector<std::string_view> getLanguages() const;
+
+		/// @brief Find localized value without exceptions
+		/// @param key Localization key
+		/// @param language Specific language
+		/// @return Null terminated value or nullptr if key or language doesn't exist
+		const char* find(std::string_view key, std::string_view language) const noexcept;
+
+		/// @brief Get localized text
+		/// @param key Localization key
+		/// @param language Specific language
+		/// @param allowOriginal If can't find text for specific language try to find in original language
+		/// @return Localized value
+		/// @exception std::runtime_error Wrong key
+		std::string_view getString(std::string_view key, std::string_view language, bool allowOriginal = true) const;
+
+		/// @brief Get total number of hash table slots of all languages
+		size_t getSlotsCount() const;
+
+		/// @brief Find global slot index of key
+		/// @param key Localization key
+		/// @param language Specific language
+		/// @return Index in [0, getSlotsCount()) or npos if key or language doesn't exist
+		size_t findSlot(std::string_view key, std::string_view language) const noexcept;
+
+		/// @brief Get language and key of slot
+		/// @param slot Index in [0, getSlotsCount())
+		/// @return Language and key. Key is empty for empty slot
+		/// @exception std::out_of_range
+		std::pair<std::string_view, std::string_view> getSlot(size_t slot) const;
+
+		/// @brief Get hash table statistics
+		/// @param language Specific language
+		/// @exception std::runtime_error Wrong language
+		ProbeStatistics getProbeStatistics(std::string_view language) const;
+
+		explicit operator bool() const;
+
+		~DictionaryImage() = default;
+	};
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+/// @file LocaleData.h
+/// @brief Per language number, currency and date formatting without std::locale
+
+#include <string>
+#include <string_view>
+#include <span>
+#include <chrono>
+#include <cstdint>
+
+#include "LocalizationConstants.h"
+
+namespace localization
+{
+	/// @brief Formatting data of single language. Formatters write into caller provided buffers and never allocate
+	/// @details Values are loaded from reserved keys of module dictionaries(see localization::locale namespace). Missing keys use built-in defaults of language
+	struct LOCALIZATION_API LocaleData
+	{
+	public:
+		/// @brief Separator between integer and fractional parts. UTF-8
+		std::string decimalSeparator;
+		/// @brief Separator between digit groups. UTF-8
+		std::string groupSeparator;
+		/// @brief Size of first digit group from the right. 0 disables grouping
+		uint8_t primaryGroupSize;
+		/// @brief Size of all other digit groups
+		uint8_t secondaryGroupSize;
+		/// @brief Currency pattern. # is replaced with number, currency sign(U+00A4) with currency symbol
+		std::string currencyPattern;
+		/// @brief Date pattern. Supports d, dd, M, MM, yy, yyyy and 'quoted literals'
+		std::string datePattern;
+		/// @brief Time pattern. Supports H, HH, h, hh, m, mm, s, ss, a and 'quoted literals'
+		std::string timePattern;
+		/// @brief Marker for a in time pattern before noon
+		std::string amMarker;
+		/// @brief Marker for a in time pattern after noon
+		std::string pmMarker;
+
+	public:
+		/// @brief Built-in defaults for language. Unknown languages get en defaults
+		/// @param language Language key. Region suffix(en_US, ru-RU) is ignored
+		LocaleData(std::string_view language = "en");
+
+		/// @brief Set value from module dictionary
+		/// @param key One of localization::locale keys
+		/// @param value Value from dictionary
+		/// @return Key is known
+		bool setValue(std::string_view key, std::string_view value);
+
+		/// @brief Format integer with digit grouping
+		/// @param buffer Output buffer
+		/// @return View of written part of buffer. Empty if buffer is too small
+		std::string_view formatInteger(std::span<char> buffer, int64_t value) const;
+
+		/// @brief Format number with fixed precision and digit grouping
+		/// @param buffer Output buffer
+		/// @param precision Number of fractional digits
+		/// @return View of written part of buffer. Empty if buffer is too small
+		std::string_view formatDecimal(std::span<char> buffer, double value, int precision = 2) const;
+
+		/// @brief Format price with currencyPattern
+		/// @param buffer Output buffer
+		/// @param symbol Currency symbol or code
+		/// @param precision Number of fractional digits
+		/// @return View of written part of buffer. Empty if buffer is too small
+		std::string_view formatCurrency(std::span<char> buffer, double value, std::string_view symbol, int precision = 2) const;
+
+		/// @brief Format date with datePattern
+		/// @param buffer Output buffer
+		/// @return View of written part of buffer. Empty if buffer is too small
+		std::string_view formatDate(std::span<char> buffer, const std::chrono::year_month_day& date) const;
+
+		/// @brief Format time of day with timePattern
+		/// @param buffer Output buffer
+		/// @param time Time since midnight
+		/// @return View of written part of buffer. Empty if buffer is too small
+		std::string_view formatTime(std::span<char> buffer, std::chrono::seconds time) const;
+
+		~LocaleData() = default;
+	};
+}
@@ -2,21 +2,51 @@
 
 #include <string>
 
-#ifdef __LINUX__
-#define LOCALIZATION_API __attribute__((visibility("default")))
-#else
-#define LOCALIZATION_API __declspec(dllexport)
-
-#pragma warning(disable: 4251)
-#endif
+#include "LocalizationExport.h"
 
 namespace localization
 {
 	inline constexpr std::string_view localizationModulesFile = "localization_modules.json";
+	/// @brief Environment variable with path to trace file. Enables LookupTracer
+	inline constexpr std::string_view traceEnvironmentVariable = "LOCALIZATION_TRACE";
+	/// @brief Environment variable with path to usage profile written at exit. Enables usage recording
+	inline constexpr std::string_view usageEnvironmentVariable = "LOCALIZATION_USAGE";
 
 	namespace settings
 	{
 		inline const std::string defaultModuleSetting = "defaultModule";
 		inline const std::string modulesSetting = "modules";
+		inline const std::string overlaysSetting = "overlays";
+		inline const std::string reverseIndexSetting = "reverseIndex";
+		inline const std::string keyNormalizationSetting = "keyNormalization";
+		inline const std::string arenaSetting = "arena";
+		inline const std::string numaReplicasSetting = "numaReplicas";
+		inline const std::string usageProfileSetting = "usageProfile";
+	}
+
+	/// @brief Reserved dictionary keys with LocaleData values
+	namespace locale
+	{
+		inline constexpr std::string_view decimalSeparatorKey = "locale.decimalSeparator";
+		inline constexpr std::string_view groupSeparatorKey = "locale.groupSeparator";
+		/// @brief Primary and optional secondary group sizes. 3 or 3;2
+		inline constexpr std::string_view groupingKey = "locale.grouping";
+		inline constexpr std::string_view currencyPatternKey = "locale.currencyPattern";
+		inline constexpr std::string_view datePatternKey = "locale.datePattern";
+		inline constexpr std::string_view timePatternKey = "locale.timePattern";
+		inline constexpr std::string_view amMarkerKey = "locale.am";
+		inline constexpr std::string_view pmMarkerKey = "locale.pm";
+
+		inline constexpr std::string_view keys[] =
+		{
+			decimalSeparatorKey,
+			groupSeparatorKey,
+			groupingKey,
+			currencyPatternKey,
+			datePatternKey,
+			timePatternKey,
+			amMarkerKey,
+			pmMarkerKey
+		};
 	}
 }
@@ -0,0 +1,12 @@
+#pragma once
+
+/// @file LocalizationExport.h
+/// @brief Export macro without any other declarations
+
+#ifdef __LINUX__
+#define LOCALIZATION_API __attribute__((visibility("default")))
+#else
+#define LOCALIZATION_API __declspec(dllexport)
+
+#pragma warning(disable: 4251)
+#endif
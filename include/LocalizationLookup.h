@@ -0,0 +1,76 @@
+#pragma once
+
+/// @file LocalizationLookup.h
+/// @brief Lookup only API. Doesn't include loader, JSON, platform or containers headers, use it in translation units that only read localized values
+
+#include <string_view>
+
+#include "LocalizationExport.h"
+
+namespace localization
+{
+	template<typename T>
+	class BaseTextLocalization;
+
+	/// @brief Opaque handle of loaded localization module. Cheap to copy
+	/// @details Looks up module directly without MultiLocalizationManager overlays, key normalization, usage profile and usage recording. Valid while module is loaded
+	class LOCALIZATION_API LookupHandle
+	{
+	private:
+		using DictionariesFunction = const char* (*)(const char* key, const char* language);
+
+	private:
+		DictionariesFunction dictionaries;
+		const BaseTextLocalization<char>* localization;
+
+	private:
+		LookupHandle(const BaseTextLocalization<char>* localization);
+
+	public:
+		/// @brief Empty handle
+		LookupHandle();
+
+		/// @brief Find localized value without exceptions
+		/// @param key Null terminated localization key
+		/// @param language Null terminated language
+		/// @return Null terminated value or nullptr. Always nullptr for empty handle
+		const char* find(std::string_view key, std::string_view language) const noexcept
+		{
+			return dictionaries ? dictionaries(key.data(), language.data()) : nullptr;
+		}
+
+		/// @brief Get localized text
+		/// @param key Localization key
+		/// @param language Specific language. Current language of module if empty
+		/// @param allowOriginal If can't find text for specific language try to find in original language
+		/// @return Localized value
+		/// @exception std::runtime_error Wrong key
+		std::string_view getString(std::string_view key, std::string_view language = "", bool allowOriginal = true) const;
+
+		/// @brief Get current language of module
+		std::string_view getCurrentLanguage() const;
+
+		/// @brief Get original language of module
+		std::string_view getOriginalLanguage() const;
+
+		explicit operator bool() const;
+
+		~LookupHandle() = default;
+
+		friend LOCALIZATION_API LookupHandle getLookupHandle(std::string_view localizationModuleName);
+	};
+
+	/// @brief Get handle of module. Thread safe
+	/// @param localizationModuleName Name of module loaded by MultiLocalizationManager. Default module if empty
+	/// @return Handle valid while module is loaded
+	/// @exception std::runtime_error Wrong module
+	LOCALIZATION_API LookupHandle getLookupHandle(std::string_view localizationModuleName = "");
+
+	/// @brief Same as MultiLocalizationManager::getLocalizedString. Thread safe
+	/// @param localizationModuleName Name of module
+	/// @param key Localization key
+	/// @param language Localized value from specific language
+	/// @return Localized value
+	/// @exception std::runtime_error Wrong key
+	LOCALIZATION_API std::string_view getLocalizedString(std::string_view localizationModuleName, std::string_view key, std::string_view language = "");
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+/// @file LookupTracer.h
+/// @brief Opt-in capture of MultiLocalizationManager lookups for offline replay
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <filesystem>
+#include <cstdint>
+
+#include "LocalizationConstants.h"
+
+namespace localization
+{
+	/// @brief Outcome of lookup
+	enum class LookupResult : uint8_t
+	{
+		hit,
+		miss,
+		/// @brief Value was taken from original language
+		fallback
+	};
+
+	/// @brief Single traced lookup
+	struct LOCALIZATION_API TraceRecord
+	{
+		/// @brief Nanoseconds since tracer start
+		uint64_t timestamp;
+		/// @brief Sequential id of traced thread
+		uint32_t thread;
+		LookupResult result;
+		/// @brief Module, language or key was longer than traced size and its string is cut, so lookup can't be repeated
+		bool truncated;
+		/// @brief Index in LookupTrace strings
+		uint32_t module;
+		/// @brief Index in LookupTrace strings
+		uint32_t language;
+		/// @brief Index in LookupTrace strings
+		uint32_t key;
+	};
+
+	/// @brief Trace file loaded in memory
+	struct LOCALIZATION_API LookupTrace
+	{
+		std::vector<std::string> strings;
+		/// @brief Records ordered by timestamp
+		std::vector<TraceRecord> records;
+
+		/// @brief Load trace file
+		/// @param pathToTrace Path to file written by LookupTracer
+		/// @exception std::runtime_error Can't open file or wrong format
+		static LookupTrace load(const std::filesystem::path& pathToTrace);
+	};
+
+	/// @brief Records lookups into per thread lock free ring buffers. Background thread flushes them into compact binary file
+	/// @details Tracing thread never blocks. If its ring buffer is full record is dropped and counted. Strings longer than record fields are truncated and their records are marked.
+	/// Background thread takes registry lock only to copy list of buffers and writes file after releasing it
+	class LOCALIZATION_API LookupTracer
+	{
+	public:
+		/// @brief Maximum traced module name size
+		static constexpr size_t maxModuleSize = 24;
+		/// @brief Maximum traced language size
+		static constexpr size_t maxLanguageSize = 16;
+		/// @brief Maximum traced key size
+		static constexpr size_t maxKeySize = 72;
+
+	public:
+		LookupTracer() = delete;
+
+		/// @brief Start tracing. Also started by MultiLocalizationManager if LOCALIZATION_TRACE environment variable contains path
+		/// @param pathToTrace Output file. Overwritten
+		/// @param recordsPerThread Ring buffer size of each thread. Rounded up to power of 2
+		/// @param flushPeriod How often background thread drains ring buffers
+		/// @exception std::runtime_error Tracing is already started or can't open file
+		static void start(const std::filesystem::path& pathToTrace, size_t recordsPerThread = 1 << 16, std::chrono::milliseconds flushPeriod = std::chrono::milliseconds(100));
+
+		/// @brief Stop tracing, flush remaining records and close file
+		/// @return Number of dropped records
+		static uint64_t stop();
+
+		/// @brief Check if tracing is enabled. Single relaxed atomic load
+		static bool isEnabled();
+
+		/// @brief Record lookup of calling thread
+		static void record(std::string_view module, std::string_view language, std::string_view key, LookupResult result) noexcept;
+	};
+}
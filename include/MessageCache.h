@@ -0,0 +1,194 @@
+#pragma once
+
+/// @file MessageCache.h
+/// @brief Bounded cache of rendered messages
+
+#include <string>
+#include <string_view>
+#include <span>
+#include <type_traits>
+#include <memory>
+#include <atomic>
+#include <cstdint>
+
+#include "LocalizationConstants.h"
+
+namespace localization
+{
+	/// @brief Formatting argument of MultiLocalizationManager::getRenderedString. Messages are formatted out of line, so public headers don't include <format>
+	/// @details Keeps copy of arithmetic value or view of string that must be valid during formatting. Format specification is the same as of argument type, nested replacement fields in it aren't supported
+	struct LOCALIZATION_API MessageArgument
+	{
+	public:
+		enum class Type : uint8_t
+		{
+			none,
+			boolean,
+			character,
+			signedInteger,
+			unsignedInteger,
+			singlePrecision,
+			doublePrecision,
+			string
+		};
+
+	public:
+		/// @brief Maximum number of arguments of single message
+		static constexpr size_t maxCount = 16;
+
+	public:
+		Type type;
+		union
+		{
+			bool boolean;
+			char character;
+			int64_t signedInteger;
+			uint64_t unsignedInteger;
+			float singlePrecision;
+			double doublePrecision;
+			std::string_view string;
+		};
+
+	public:
+		/// @brief Format message. Defined with std::formatter of MessageArgument in src/MessageCache.cpp
+		/// @param format std::format format string
+		/// @param arguments At most maxCount arguments
+		/// @return Formatted message
+		/// @exception std::format_error Wrong format string or missing argument
+		static std::string render(std::string_view format, std::span<const MessageArgument> arguments);
+
+	public:
+		/// @brief Missing argument. Formatting it throws std::format_error
+		MessageArgument() noexcept;
+
+		/// @brief Wrap argument
+		/// @param value Arithmetic value or value convertible to std::string_view
+		template<typename T>
+		MessageArgument(const T& value) noexcept;
+	};
+
+	/// @brief Sharded CLOCK cache of rendered messages keyed on (module, language, key, arguments hash)
+	/// @details Hits take shared lock of single shard. Returned messages stay valid after eviction or invalidation.
+	/// Each invalidation advances epoch of module, insert drops messages rendered in earlier epoch, so value read before invalidation is never cached after it
+	class LOCALIZATION_API MessageCache
+	{
+	public:
+		struct LOCALIZATION_API Statistics
+		{
+			uint64_t hits;
+			uint64_t misses;
+			uint64_t evictions;
+			size_t entries;
+			size_t capacity;
+			/// @brief Approximate heap memory used by cached entries in bytes
+			size_t memoryUsage;
+
+			/// @brief Part of hits in all lookups
+			double getHitRate() const;
+		};
+
+	private:
+		struct Slot;
+		struct Shard;
+
+	private:
+		/// @brief Modules share epochs by hash of name, collision only drops some inserts
+		static constexpr size_t epochsCount = 64;
+
+	private:
+		std::unique_ptr<Shard[]> shards;
+		size_t shardsCount;
+		std::unique_ptr<std::atomic<uint64_t>[]> epochs;
+
+	private:
+		static uint64_t hash(std::string_view module, std::string_view language, std::string_view key, uint64_t arguments);
+
+		static bool isSame(const Slot& slot, std::string_view module, std::string_view language, std::string_view key, uint64_t arguments);
+
+		static size_t getMemoryUsage(const Slot& slot);
+
+		static void release(Shard& shard, Slot& slot);
+
+		Shard& getShard(uint64_t hash) const;
+
+		std::atomic<uint64_t>& getModuleEpoch(std::string_view module) const;
+
+	public:
+		/// @brief Combine types and values of formatting arguments. Arguments of different types or with different bits, like 'a' and 97 or 0.0 and -0.0, have different hashes
+		static uint64_t hashArguments(std::span<const MessageArgument> arguments);
+
+	public:
+		/// @brief Create cache
+		/// @param capacity Maximum number of messages
+		/// @param shardsCount Number of independently locked shards. Number of hardware threads if 0
+		MessageCache(size_t capacity, size_t shardsCount = 0);
+
+		MessageCache(const MessageCache&) = delete;
+
+		MessageCache& operator = (const MessageCache&) = delete;
+
+		/// @brief Find rendered message
+		/// @return Message or nullptr
+		std::shared_ptr<const std::string> find(std::string_view module, std::string_view language, std::string_view key, uint64_t arguments) const;
+
+		/// @brief Get invalidation epoch of module. Read it before localized value of message
+		uint64_t getEpoch(std::string_view module) const;
+
+		/// @brief Add rendered message. Evicts least recently used message of shard if it's full
+		/// @param epoch Result of getEpoch before message was rendered. Message isn't cached if module was invalidated since then
+		/// @return Cached or only created message
+		std::shared_ptr<const std::string> insert(std::string_view module, std::string_view language, std::string_view key, uint64_t arguments, std::string&& message, uint64_t epoch);
+
+		/// @brief Remove all messages of module and advance its epoch
+		void invalidate(std::string_view module);
+
+		/// @brief Remove all messages and advance epochs of all modules
+		void clear();
+
+		Statistics getStatistics() const;
+
+		~MessageCache();
+	};
+
+	template<typename T>
+	MessageArgument::MessageArgument(const T& value) noexcept
+	{
+		if constexpr (std::is_same_v<T, bool>)
+		{
+			type = Type::boolean;
+			boolean = value;
+		}
+		else if constexpr (std::is_same_v<T, char>)
+		{
+			type = Type::character;
+			character = value;
+		}
+		else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>)
+		{
+			type = Type::signedInteger;
+			signedInteger = value;
+		}
+		else if constexpr (std::is_integral_v<T>)
+		{
+			type = Type::unsignedInteger;
+			unsignedInteger = value;
+		}
+		else if constexpr (std::is_same_v<T, float>)
+		{
+			type = Type::singlePrecision;
+			singlePrecision = value;
+		}
+		else if constexpr (std::is_floating_point_v<T>)
+		{
+			type = Type::doublePrecision;
+			doublePrecision = static_cast<double>(value);
+		}
+		else
+		{
+			static_assert(std::is_convertible_v<const T&, std::string_view>, "Formatting argument must be arithmetic or convertible to std::string_view");
+
+			type = Type::string;
+			string = value;
+		}
+	}
+}
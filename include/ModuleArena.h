@@ -0,0 +1,87 @@
+#pragma once
+
+/// @file ModuleArena.h
+/// @brief Per module memory resource over large page aligned chunks
+
+#include <memory_resource>
+#include <vector>
+
+#include "ArenaOptions.h"
+
+namespace localization
+{
+	/// @brief Bump allocator that keeps all strings and tables of module in few contiguous chunks
+	/// @details Deallocation is no-op, memory is returned to OS by single release. First chunk is single page and each next chunk is twice larger up to Options::chunkSize,
+	/// so small structures don't reserve whole chunk. Not thread safe, like std::pmr::monotonic_buffer_resource
+	class LOCALIZATION_API ModuleArena : public std::pmr::memory_resource
+	{
+	public:
+		/// @brief Declared in ArenaOptions.h, so headers can take options without memory resource headers
+		using Options = ArenaOptions;
+
+		struct LOCALIZATION_API Statistics
+		{
+			size_t chunks;
+			/// @brief Size of all chunks in bytes
+			size_t reservedBytes;
+			/// @brief Allocated bytes including alignment padding
+			size_t usedBytes;
+			/// @brief Bytes of chunks backed by explicit huge pages
+			size_t hugePagesBytes;
+			/// @brief Bytes of chunks locked in RAM
+			size_t lockedBytes;
+		};
+
+	private:
+		struct Chunk
+		{
+			std::byte* data;
+			size_t size;
+			bool hugePages;
+			bool locked;
+		};
+
+	private:
+		Options options;
+		std::vector<Chunk> chunks;
+		std::byte* current;
+		size_t remaining;
+		size_t usedBytes;
+		size_t nextChunkSize;
+
+	private:
+		/// @return Beginning of chunk
+		std::byte* addChunk(size_t minimumSize);
+
+	private:
+		void* do_allocate(size_t bytes, size_t alignment) override;
+
+		void do_deallocate(void* pointer, size_t bytes, size_t alignment) override;
+
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+	public:
+		/// @brief Arena with normal pages. Chunks are allocated on first allocation
+		ModuleArena();
+
+		/// @brief Chunks are allocated on first allocation
+		ModuleArena(const Options& options);
+
+		ModuleArena(const ModuleArena&) = delete;
+
+		ModuleArena(ModuleArena&&) noexcept = delete;
+
+		ModuleArena& operator = (const ModuleArena&) = delete;
+
+		ModuleArena& operator = (ModuleArena&&) noexcept = delete;
+
+		/// @brief Return all chunks to OS. Objects allocated from arena must not be used after
+		void release();
+
+		const Options& getOptions() const;
+
+		Statistics getStatistics() const;
+
+		~ModuleArena();
+	};
+}
@@ -1,16 +1,31 @@
 #pragma once
 
 #include <unordered_map>
+#include <unordered_set>
 #include <filesystem>
-#include <shared_mutex>
+#include <memory>
+#include <atomic>
+#include <span>
 
-#include <JsonParser.h>
 #include "TextLocalization.h"
 #include "WTextLocalization.h"
+#include "OverlayTable.h"
+#include "NormalizedKeyIndex.h"
+#include "MessageCache.h"
+#include "ArenaOptions.h"
 #include "StringViewUtils.h"
 
 namespace localization
 {
+	class ModuleArena;
+	class ReverseIndex;
+	class NumaReplicas;
+	class UsageProfile;
+	class UsageRecorder;
+#ifdef __LINUX__
+	class SharedDictionary;
+#endif
+
 	/// @brief Manage multi localization modules and multi localization itself
 	class LOCALIZATION_API MultiLocalizationManager
 	{
@@ -18,35 +33,153 @@ namespace localization
 		struct LOCALIZATION_API LocalizationHolder
 		{
 		public:
+#ifndef __LINUX__
+			/// @brief Wide dictionaries replaced by setUsageProfile. Localization is declared after its arena, so it's destroyed first
+			struct RetiredWideLocalization
+			{
+				std::unique_ptr<ModuleArena> arena;
+				std::unique_ptr<WTextLocalization> wlocalization;
+			};
+#endif
+
+		public:
+			/// @brief Memory of holder itself. Owned by MultiLocalizationManager
+			ModuleArena* arena;
 			TextLocalization localization;
 #ifndef __LINUX__
+			/// @brief Memory of wide dictionaries. Replaced with dictionaries when usage profile changes
+			std::unique_ptr<ModuleArena> wideArena;
+			/// @brief Converted dictionaries, pruned by usage profile. Other values are converted on first lookup
 			WTextLocalization wlocalization;
+			/// @brief Kept until releaseRetired or module removal, because values returned from them may still be used
+			std::vector<RetiredWideLocalization> retiredWideLocalizations;
 #endif
+			/// @brief Memory of overlay table. Replaced and released with table when it's rebuilt
+			std::unique_ptr<ModuleArena> overlayArena;
+			/// @brief Merged table if module overlays other modules
+			std::unique_ptr<OverlayTable> overlay;
+			/// @brief Memory of normalized keys index. Replaced and released with index when it's rebuilt
+			std::unique_ptr<ModuleArena> normalizedKeysArena;
+			/// @brief Index of normalized keys if module has key normalization policy
+			std::unique_ptr<NormalizedKeyIndex> normalizedKeys;
+			/// @brief Copies of decoded dictionaries on each NUMA node if module is replicated, pruned by usage profile. Points into builtReplicas
+			const NumaReplicas* replicas;
+			/// @brief All copies built for module. Replaced copies are kept until releaseRetired or module removal, because values returned from them may still be used, and are reused if their configuration returns
+			std::vector<std::unique_ptr<NumaReplicas>> builtReplicas;
+			/// @brief Memory of usage recorder. Released with recorder when recording stops
+			std::unique_ptr<ModuleArena> usageArena;
+			/// @brief Resolved keys while usage recording is enabled
+			std::unique_ptr<UsageRecorder> usage;
 
 		public:
 #ifdef __LINUX__
-			LocalizationHolder(TextLocalization&& localization) noexcept;
+			LocalizationHolder(ModuleArena* arena, TextLocalization&& localization) noexcept;
 #else
-			LocalizationHolder(TextLocalization&& localization, WTextLocalization&& wlocalization) noexcept;
+			LocalizationHolder(ModuleArena* arena, TextLocalization&& localization, WTextLocalization&& wlocalization) noexcept;
 #endif
 
 			LocalizationHolder(const LocalizationHolder&) = delete;
 
 			LocalizationHolder& operator = (const LocalizationHolder&) = delete;
 
-			LocalizationHolder(LocalizationHolder&& other) noexcept = default;
+			LocalizationHolder(LocalizationHolder&& other) noexcept;
+
+			LocalizationHolder& operator = (LocalizationHolder&& other) noexcept;
 
-			LocalizationHolder& operator = (LocalizationHolder&& other) noexcept = default;
+			~LocalizationHolder();
 		};
 
 	private:
-		json::JsonParser settings;
+		/// @brief std::shared_mutex, defined in src/MultiLocalizationManager.cpp so this header doesn't include <shared_mutex>
+		class MapMutex;
+
+		/// @brief Background build of ReverseIndex, defined in src/MultiLocalizationManager.cpp so this header doesn't include <future>
+		struct ReverseIndexBuild;
+
+	private:
 		std::string defaultModuleName;
-		mutable std::shared_mutex mapMutex;
+		std::unique_ptr<MapMutex> mapMutex;
 		std::unordered_map<std::string, LocalizationHolder*, utility::StringViewHash, utility::StringViewEqual> localizations;
+		std::unordered_map<std::string, std::string, utility::StringViewHash, utility::StringViewEqual> overlayBases;
+		std::unordered_map<std::string, std::unique_ptr<ReverseIndexBuild>, utility::StringViewHash, utility::StringViewEqual> reverseIndexes;
+		/// @brief Modules whose ReverseIndex is built again when they are added again
+		std::unordered_set<std::string, utility::StringViewHash, utility::StringViewEqual> reverseIndexModules;
+		std::unordered_map<std::string, KeyNormalization, utility::StringViewHash, utility::StringViewEqual> keyNormalizations;
+		std::unique_ptr<NormalizedKeyIndex> defaultNormalizedKeys;
+		/// @brief Default module lookups lock mapMutex only if it has key normalization policy or replicas
+		std::atomic<bool> defaultKeyNormalization;
+		std::unordered_set<std::string, utility::StringViewHash, utility::StringViewEqual> replicatedModules;
+		const NumaReplicas* defaultReplicas;
+		std::vector<std::unique_ptr<NumaReplicas>> defaultBuiltReplicas;
+		std::atomic<bool> defaultReplication;
+		/// @brief Empty profile doesn't restrict modules. Never nullptr
+		std::unique_ptr<UsageProfile> usageProfile;
+		std::unique_ptr<UsageRecorder> defaultUsage;
+		std::atomic<bool> usageRecording;
+		/// @brief Usage profile written by destructor if usage recording was started by environment variable
+		std::string pathToUsage;
+		/// @brief Current cache, read by getRenderedString without mapMutex
+		std::atomic<MessageCache*> messageCache;
+		/// @brief Current and replaced caches. Replaced caches are cleared and kept until destruction, because concurrent getRenderedString may still use them
+		std::vector<std::unique_ptr<MessageCache>> messageCaches;
+		ArenaOptions arenaOptions;
+#ifdef __LINUX__
+		std::unordered_map<std::string, std::unique_ptr<SharedDictionary>, utility::StringViewHash, utility::StringViewEqual> sharedModules;
+		/// @brief Detached and replaced shared modules. Kept until releaseRetired, because values returned from them may still be used
+		std::vector<std::unique_ptr<SharedDictionary>> detachedSharedModules;
+#endif
+
+	private:
+		static LocalizedValue getValue(const TextLocalization& text, std::string_view localizationModuleName, std::string_view key, std::string_view language);
+
+		/// @brief Get value from copy on node of calling thread
+		static LocalizedValue getReplicaValue(const NumaReplicas& replicas, const TextLocalization& text, std::string_view localizationModuleName, std::string_view key, std::string_view language);
+
+		/// @brief Get original key if module has key normalization policy. mapMutex must be locked
+		static std::string_view resolveKey(const NormalizedKeyIndex* normalizedKeys, std::string_view key);
+
+		/// @brief Destroy holder and release its arena
+		static void destroyModule(LocalizationHolder* holder);
+
+		/// @brief Lookup without tracing and usage recording
+		LocalizedValue findLocalizedValue(std::string_view localizationModuleName, std::string_view key, std::string_view language) const;
+
+		/// @brief Lookup with tracing and usage recording
+		LocalizedValue getInstrumentedLocalizedValue(std::string_view localizationModuleName, std::string_view key, std::string_view language) const;
+
+		/// @brief Mark resolved key in recorder of module that provided value
+		void recordUsage(std::string_view localizationModuleName, std::string_view key, std::string_view language, const LocalizedValue& result) const;
+
+		/// @brief Start background build of ReverseIndex. mapMutex must be locked
+		void startReverseIndex(const std::string& localizationModuleName, const TextLocalization& text);
+
+		/// @brief Select copies of module if it's replicated, stop using them otherwise. Copies are pruned by usage profile, built once per configuration and kept until releaseRetired. mapMutex must be locked
+		void updateReplicas(std::string_view localizationModuleName, const TextLocalization& text, const NumaReplicas*& replicas, std::vector<std::unique_ptr<NumaReplicas>>& builtReplicas);
+
+		/// @brief Build index of normalized keys pruned by usage profile and replace previous index. KeyNormalization::none removes index. mapMutex must be locked
+		/// @param normalizedKeysArena Arena of index. Default resource is used if nullptr
+		void buildNormalizedKeys(std::string_view localizationModuleName, const TextLocalization& text, KeyNormalization normalization, std::unique_ptr<NormalizedKeyIndex>& normalizedKeys, std::unique_ptr<ModuleArena>* normalizedKeysArena);
+
+		/// @brief Get current language of module or empty string for shared modules. mapMutex must be locked
+		std::string_view getCurrentLanguage(std::string_view localizationModuleName) const;
+
+		/// @brief Remove cached rendered messages of module. mapMutex must be locked
+		void invalidateMessages(std::string_view localizationModuleName);
+
+		/// @brief Find cached message or format and cache it. Locks mapMutex on cache hit only to read current language of added module. Hits are traced and recorded like lookups
+		std::shared_ptr<const std::string> renderString(std::string_view localizationModuleName, std::string_view key, std::string_view language, std::span<const MessageArgument> arguments) const;
+
+		/// @brief Singleton instance created by first call
+		/// @param loadModules Load default module and modules from localization_modules.json
+		static MultiLocalizationManager& getInstance(bool loadModules);
+
+		/// @brief Rebuild merged tables of overlay modules that depend on changed module. Tables are replaced only if all of them are built. mapMutex must be locked
+		/// @param changedModuleName Empty name rebuilds all tables
+		/// @exception std::runtime_error Module doesn't export dictionaries functions
+		void rebuildOverlays(std::string_view changedModuleName);
 
 	private:
-		MultiLocalizationManager();
+		MultiLocalizationManager(bool loadModules);
 
 		MultiLocalizationManager(const MultiLocalizationManager&) = delete;
 
@@ -66,20 +199,38 @@ namespace localization
 		static std::string getVersion();
 
 	public:
-		/// @brief Singleton instance
+		/// @brief Singleton instance. Warnings outputs in std::cerr
 		/// @return MultiLocalizationManager
 		/// @exception std::runtime_error
 		/// @exception json::exceptions::CantFindValueException 
 		/// @exception std::bad_variant_access Other type found
 		static MultiLocalizationManager& getManager();
 
+#ifdef __LINUX__
+		/// @brief Singleton instance for worker processes that only attach shared modules
+		/// @details If it's first call, neither default module nor modules from localization_modules.json are loaded and settings file isn't required, so attaching shared module is single mmap.
+		/// Default module is loaded by its first lookup. Returns already created instance if getManager was called before
+		/// @return MultiLocalizationManager
+		static MultiLocalizationManager& getSharedManager();
+#endif
+
+		/// @brief Get name of module used by TextLocalization::get
+		std::string_view getDefaultModuleName() const;
+
 		/// @brief Add additional localization module. Thread safe
 		/// @param localizationModuleName Name of module
-		/// @param pathToLocalizationModule Path to localization module
+		/// @param pathToLocalizationModule Path to localization module file if it has directory, otherwise module name. If empty localizationModuleName is used
 		/// @return Pointer to MultiLocalizationManager::LocalizationHolder 
-		/// @exception std::runtime_error
+		/// @exception std::runtime_error Can't load module or shared module with the same name is attached
 		LocalizationHolder* addModule(const std::string& localizationModuleName, const std::filesystem::path& pathToLocalizationModule = "");
 
+		/// @brief Set options of arenas created after this call for new modules, wide dictionaries, overlay tables, normalized keys and reverse indexes and usage recorders. Also set by arena setting. Thread safe
+		/// @param options Pages and locking of arena chunks
+		void setArenaOptions(const ArenaOptions& options);
+
+		/// @brief Get options of arenas created for new modules. Thread safe
+		ArenaOptions getArenaOptions() const;
+
 		/// @brief Remove localization module. Thread safe
 		/// @param localizationModuleName Name of module
 		/// @return Module was successfully removed
@@ -91,6 +242,122 @@ namespace localization
 		/// @exception std::runtime_error
 		LocalizationHolder* getModule(std::string_view localizationModuleName) const;
 
+		/// @brief Declare that one module overlays another. Values of overlay module take precedence over base module values. Chains of overlays are supported, modules of chain that aren't loaded are skipped. Thread safe
+		/// @param overlayModuleName Name of overlay module
+		/// @param baseModuleName Name of base module. Can be default module
+		/// @exception std::runtime_error Overlay module is default module or overlays create cycle
+		void addOverlay(const std::string& overlayModuleName, const std::string& baseModuleName);
+
+		/// @brief Remove overlay declaration. Thread safe
+		/// @param overlayModuleName Name of overlay module
+		/// @return Overlay was successfully removed
+		bool removeOverlay(std::string_view overlayModuleName);
+
+		/// @brief Start building ReverseIndex of module in background thread. Also started for modules listed in reverseIndex setting. Index is built again if module is removed and added again. Thread safe
+		/// @param localizationModuleName Name of module. Can be default module
+		/// @exception std::runtime_error Wrong module
+		void buildReverseIndex(const std::string& localizationModuleName);
+
+		/// @brief Remove ReverseIndex of module, it isn't built again when module is added. Waits for background build without blocking lookups. Thread safe
+		/// @param localizationModuleName Name of module
+		/// @return Index was successfully removed
+		bool dropReverseIndex(std::string_view localizationModuleName);
+
+		/// @brief Get ReverseIndex of module. Thread safe
+		/// @param localizationModuleName Name of module
+		/// @param wait Wait for background build
+		/// @return Index or nullptr if index wasn't requested or isn't built yet
+		/// @exception std::runtime_error Index build failed
+		std::shared_ptr<const ReverseIndex> getReverseIndex(std::string_view localizationModuleName, bool wait = true) const;
+
+		/// @brief Set key normalization policy of module and build index of normalized keys. Policy is kept if module is removed and added again. Thread safe
+		/// @param localizationModuleName Name of module. Can be default module
+		/// @param normalization Normalization policy. KeyNormalization::none removes policy
+		/// @return Keys ignored because of the same normalized form
+		/// @exception std::runtime_error Wrong module
+		std::vector<NormalizedKeyIndex::Ambiguity> setKeyNormalization(const std::string& localizationModuleName, KeyNormalization normalization);
+
+		/// @brief Get keys ignored by key normalization policy of module. Thread safe
+		/// @param localizationModuleName Name of module
+		/// @return Keys ignored because of the same normalized form
+		std::vector<NormalizedKeyIndex::Ambiguity> getKeyAmbiguities(std::string_view localizationModuleName) const;
+
+		/// @brief Keep read only copy of decoded dictionaries of module on each NUMA node. Lookups read copy of node of calling thread. Single copy on single node machine. Kept if module is removed and added again. Also enabled for modules listed in numaReplicas setting. Thread safe
+		/// @details Each copy takes size of DictionaryImage of module: all keys and values with hash tables
+		/// @param localizationModuleName Name of module. Can be default module, then its lookups take shared lock
+		/// @return Number of copies
+		/// @exception std::runtime_error Wrong module
+		size_t enableNumaReplicas(const std::string& localizationModuleName);
+
+		/// @brief Stop reading copies of module. Copies are kept until releaseRetired, so values returned from them stay valid, and are reused if replicas are enabled again. Thread safe
+		/// @param localizationModuleName Name of module
+		/// @return Module was replicated
+		bool disableNumaReplicas(std::string_view localizationModuleName);
+
+		/// @brief Start marking keys resolved by getLocalizedString, getLocalizedValue and getRenderedString in each module. Wide strings and LookupHandle aren't recorded. Also started if LOCALIZATION_USAGE environment variable contains path, then profile is written at exit. Thread safe
+		/// @exception std::runtime_error Module doesn't export dictionaries functions
+		void startUsageRecording();
+
+		/// @brief Stop usage recording. Thread safe
+		/// @return Resolved keys of all modules. Fallback values are recorded in original language
+		UsageProfile stopUsageRecording();
+
+		/// @brief Get resolved keys so far without stopping. Thread safe
+		/// @return Resolved keys of all modules. Empty if recording isn't started
+		UsageProfile getRecordedUsage() const;
+
+		/// @brief Keep only languages and keys allowed by profile in structures built by library: NUMA replicas, overlay tables, indexes of normalized keys, reverse indexes and wide dictionaries.
+		/// Module data itself can't be pruned, so other keys are still found in module with slower lookup, except reverse index which finds only allowed values.
+		/// Structures of loaded modules are rebuilt, previous replicas and wide dictionaries are kept until releaseRetired. Applied to modules added later. Also set by usageProfile setting. Thread safe
+		/// @param profile Recorded profile or allow-list. Empty profile removes restrictions
+		/// @exception std::runtime_error Module doesn't export dictionaries functions
+		void setUsageProfile(const UsageProfile& profile);
+
+		/// @brief Get profile that restricts modules. Thread safe
+		UsageProfile getUsageProfile() const;
+
+		/// @brief Free copies and wide dictionaries replaced by enableNumaReplicas, disableNumaReplicas and setUsageProfile. Also unmap shared modules generations replaced by refreshSharedModules and shared modules detached by detachSharedModule. Thread safe
+		/// @details Values returned from replaced copies stay valid until this call or removal of module. Until then each replaced copy keeps whole DictionaryImage of module on each node,
+		/// so call it when such values aren't used anymore, for example between requests
+		/// @return Freed and unmapped bytes
+		size_t releaseRetired();
+
+		/// @brief Enable cache of messages rendered by getRenderedString. Replaces previous cache, its messages are released. Thread safe
+		/// @param capacity Maximum number of messages
+		/// @param shardsCount Number of independently locked shards. Number of hardware threads if 0
+		void enableMessageCache(size_t capacity, size_t shardsCount = 0);
+
+		/// @brief Disable cache of rendered messages. Thread safe
+		void disableMessageCache();
+
+		/// @brief Get hits, misses and memory of rendered messages cache. Thread safe
+		/// @return Statistics or zeroes if cache is disabled
+		MessageCache::Statistics getMessageCacheStatistics() const;
+
+#ifdef __LINUX__
+		/// @brief Publish decoded dictionaries of loaded module into named shared memory segment. Used by loader process before fork. Thread safe
+		/// @param localizationModuleName Name of module
+		/// @param segmentName Name of shared memory segment. Must start with /
+		/// @return Published generation
+		/// @exception std::runtime_error
+		uint64_t publishSharedModule(std::string_view localizationModuleName, std::string_view segmentName);
+
+		/// @brief Attach read only module from shared memory segment published by other process. Replaced module with the same name is detached. Thread safe
+		/// @param localizationModuleName Name of module
+		/// @param segmentName Name of shared memory segment. Must start with /
+		/// @exception std::runtime_error
+		void attachSharedModule(const std::string& localizationModuleName, std::string_view segmentName);
+
+		/// @brief Detach shared module. Its segment stays mapped until releaseRetired, so values returned from it stay valid. Thread safe
+		/// @param localizationModuleName Name of module
+		/// @return Module was successfully detached
+		bool detachSharedModule(std::string_view localizationModuleName);
+
+		/// @brief Attach newer published generations of all shared modules. Previous generations stay mapped until releaseRetired, so values returned from them stay valid. Thread safe
+		/// @return Number of refreshed modules
+		size_t refreshSharedModules();
+#endif
+
 		/// @brief Get localized text. Thread safe
 		/// @param localizationModuleName Name of module
 		/// @param key Localization key
@@ -99,6 +366,32 @@ namespace localization
 		/// @exception std::runtime_error Wrong key 
 		std::string_view getLocalizedString(std::string_view localizationModuleName, std::string_view key, std::string_view language = "") const;
 
+		/// @brief Get localized text with name of module that provides it. Thread safe
+		/// @param localizationModuleName Name of module
+		/// @param key Localization key
+		/// @param language Localized value from specific language
+		/// @return Localized value and module(layer) name
+		/// @exception std::runtime_error Wrong key 
+		LocalizedValue getLocalizedValue(std::string_view localizationModuleName, std::string_view key, std::string_view language = "") const;
+
+		/// @brief Get localized text formatted with std::format arguments. Result is cached if message cache is enabled. Thread safe
+		/// @param localizationModuleName Name of module
+		/// @param key Localization key
+		/// @param language Localized value from specific language. Current language of module if empty
+		/// @param args At most MessageArgument::maxCount formatting arguments. Must be arithmetic or convertible to std::string_view
+		/// @return Rendered message. Stays valid after cache eviction or module removal
+		/// @exception std::runtime_error Wrong key
+		/// @exception std::format_error Wrong format string
+		template<typename... Args>
+		std::shared_ptr<const std::string> getRenderedString(std::string_view localizationModuleName, std::string_view key, std::string_view language, const Args&... args) const;
+
+		/// @brief Get number, currency and date formatting data. Thread safe
+		/// @param localizationModuleName Name of module
+		/// @param language Specific language. Current language of module if empty
+		/// @return LocaleData valid while module is loaded
+		/// @exception std::runtime_error Wrong module or language
+		const LocaleData& getLocaleData(std::string_view localizationModuleName, std::string_view language = "") const;
+
 #ifndef __LINUX__
 		/// @brief Get localized text. Thread safe
 		/// @param localizationModuleName Name of module
@@ -110,5 +403,16 @@ namespace localization
 #endif
 	};
 
+	template<typename... Args>
+	std::shared_ptr<const std::string> MultiLocalizationManager::getRenderedString(std::string_view localizationModuleName, std::string_view key, std::string_view language, const Args&... args) const
+	{
+		static_assert(sizeof...(Args) <= MessageArgument::maxCount, "Too many formatting arguments");
+
+		// Last empty argument keeps array non empty
+		const MessageArgument arguments[] = { MessageArgument(args)..., MessageArgument() };
+
+		return this->renderString(localizationModuleName, key, language, std::span<const MessageArgument>(arguments, sizeof...(Args)));
+	}
+
 	using Holder = MultiLocalizationManager::LocalizationHolder;
 }
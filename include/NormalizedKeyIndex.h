@@ -0,0 +1,108 @@
+#pragma once
+
+/// @file NormalizedKeyIndex.h
+/// @brief Lookup of keys with inconsistent case and separators
+
+#include <vector>
+#include <unordered_set>
+#include <memory_resource>
+
+#include "TextLocalization.h"
+
+namespace localization
+{
+	class UsageProfile;
+
+	/// @brief Key normalization policy flags
+	enum class KeyNormalization : uint8_t
+	{
+		none = 0,
+		/// @brief Compare case folded keys
+		foldCase = 1,
+		/// @brief Ignore . _ - / : and space in keys
+		ignoreSeparators = 2,
+		all = foldCase | ignoreSeparators
+	};
+
+	inline constexpr KeyNormalization operator | (KeyNormalization left, KeyNormalization right)
+	{
+		return static_cast<KeyNormalization>(static_cast<uint8_t>(left) | static_cast<uint8_t>(right));
+	}
+
+	inline constexpr bool operator & (KeyNormalization left, KeyNormalization right)
+	{
+		return static_cast<uint8_t>(left) & static_cast<uint8_t>(right);
+	}
+
+	/// @brief Secondary index from normalized keys to original keys of module
+	/// @details Normalized form is never materialized: hash and comparison fold keys on the fly, so lookup doesn't allocate
+	class LOCALIZATION_API NormalizedKeyIndex
+	{
+	public:
+		/// @brief Original keys with the same normalized form
+		struct LOCALIZATION_API Ambiguity
+		{
+			/// @brief Key used by index
+			std::string key;
+			/// @brief Ignored key
+			std::string ignoredKey;
+		};
+
+	private:
+		struct Hash
+		{
+			using is_transparent = void;
+
+			KeyNormalization normalization;
+
+			size_t operator ()(std::string_view key) const noexcept;
+		};
+
+		struct Equal
+		{
+			using is_transparent = void;
+
+			KeyNormalization normalization;
+
+			bool operator ()(std::string_view left, std::string_view right) const noexcept;
+		};
+
+	private:
+		KeyNormalization normalization;
+		std::pmr::unordered_set<std::pmr::string, Hash, Equal> keys;
+		std::vector<Ambiguity> ambiguities;
+		/// @brief Module with keys that aren't indexed if index is pruned by usage profile
+		const TextLocalization* prunedModule;
+
+	public:
+		/// @brief Index keys of all languages of module. If keys have the same normalized form lexicographically smaller key is used
+		/// @param localization Source module. Must be valid while index is used if usage prunes keys
+		/// @param normalization Normalization policy
+		/// @param resource Memory of keys and table
+		/// @param usage Index only keys used by module in profile. Other keys are found by scan of module, so their lookups are slow
+		/// @param moduleName Name of module in usage
+		/// @exception std::runtime_error Module doesn't export dictionaries functions
+		NormalizedKeyIndex(const TextLocalization& localization, KeyNormalization normalization, std::pmr::memory_resource* resource = std::pmr::get_default_resource(), const UsageProfile* usage = nullptr, std::string_view moduleName = "");
+
+		NormalizedKeyIndex(const NormalizedKeyIndex&) = delete;
+
+		NormalizedKeyIndex(NormalizedKeyIndex&&) noexcept = default;
+
+		NormalizedKeyIndex& operator = (const NormalizedKeyIndex&) = delete;
+
+		NormalizedKeyIndex& operator = (NormalizedKeyIndex&&) noexcept = default;
+
+		/// @brief Find original key
+		/// @param key Key in any form
+		/// @return Null terminated original key or nullptr
+		const char* find(std::string_view key) const noexcept;
+
+		/// @brief Get normalization policy
+		KeyNormalization getNormalization() const;
+
+		/// @brief Get keys that were ignored because of the same normalized form
+		const std::vector<Ambiguity>& getAmbiguities() const;
+
+		~NormalizedKeyIndex() = default;
+	};
+}
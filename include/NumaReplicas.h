@@ -0,0 +1,63 @@
+#pragma once
+
+/// @file NumaReplicas.h
+/// @brief Copies of decoded dictionaries of module on each NUMA node
+
+#include <memory>
+#include <optional>
+
+#include "DictionaryImage.h"
+#include "ModuleArena.h"
+#include "NumaTopology.h"
+
+namespace localization
+{
+	/// @brief Read only DictionaryImage of module copied into memory of each NUMA node. Single copy on single node machine
+	class LOCALIZATION_API NumaReplicas
+	{
+	private:
+		std::vector<std::unique_ptr<ModuleArena>> arenas;
+		std::vector<DictionaryImage> images;
+		std::vector<uint32_t> nodes;
+		std::optional<UsageProfile::Module> usage;
+
+	public:
+		/// @brief Decode module once and copy image to each node
+		/// @param localization Source module
+		/// @param topology Nodes to place copies on. Order must match NumaTopology::getCurrentNodeIndex if getLocalImage is used
+		/// @param options Pages and locking of copies. Node is set for each copy
+		/// @param usage Copy only allowed languages and keys. Other keys must be read from module
+		/// @exception std::runtime_error Module doesn't export dictionaries functions
+		NumaReplicas(const TextLocalization& localization, const NumaTopology& topology, ModuleArena::Options options, const UsageProfile::Module* usage = nullptr);
+
+		NumaReplicas(const NumaReplicas&) = delete;
+
+		NumaReplicas(NumaReplicas&&) noexcept = default;
+
+		NumaReplicas& operator = (const NumaReplicas&) = delete;
+
+		NumaReplicas& operator = (NumaReplicas&&) noexcept = default;
+
+		/// @brief Get copy on node of calling thread
+		const DictionaryImage& getLocalImage() const noexcept;
+
+		/// @brief Get copy on specific node
+		/// @param nodeIndex Index of node in NumaTopology::getNodes
+		/// @exception std::out_of_range
+		const DictionaryImage& getImage(size_t nodeIndex) const;
+
+		/// @brief Get number of copies
+		size_t getReplicasCount() const;
+
+		/// @brief Get memory reserved by all copies in bytes
+		size_t getMemoryUsage() const;
+
+		/// @brief Copies keep only languages and keys allowed by usage profile
+		bool isPruned() const;
+
+		/// @brief Copies are placed on the same nodes and keep the same languages and keys
+		bool isBuiltWith(const NumaTopology& topology, const UsageProfile::Module* usage) const;
+
+		~NumaReplicas() = default;
+	};
+}
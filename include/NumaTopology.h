@@ -0,0 +1,53 @@
+#pragma once
+
+/// @file NumaTopology.h
+/// @brief NUMA nodes and CPUs that belong to them
+
+#include <vector>
+#include <filesystem>
+#include <cstdint>
+
+#include "LocalizationConstants.h"
+
+namespace localization
+{
+	/// @brief Nodes of machine read from sysfs. Machine without NUMA or Windows is single node 0
+	class LOCALIZATION_API NumaTopology
+	{
+	public:
+		/// @brief Default sysfs directory with node* subdirectories
+		static constexpr std::string_view defaultPathToNodes = "/sys/devices/system/node";
+
+	private:
+		std::vector<uint32_t> nodes;
+		/// @brief Index in nodes for each CPU
+		std::vector<uint32_t> cpuNodes;
+
+	public:
+		/// @brief Read online nodes and their cpulist files
+		/// @param pathToNodes Directory with online file and node<id>/cpulist files
+		/// @return Single node topology if directory doesn't exist or can't be parsed
+		static NumaTopology read(const std::filesystem::path& pathToNodes = defaultPathToNodes);
+
+		/// @brief Topology of current machine. Read once
+		static const NumaTopology& get();
+
+		/// @brief Get index of node of calling thread in getNodes of get(). Cached per thread and refreshed every 1024 calls, so migrated threads eventually pick local node
+		static size_t getCurrentNodeIndex() noexcept;
+
+	public:
+		/// @brief Single node 0
+		NumaTopology();
+
+		/// @brief Get node ids in ascending order
+		const std::vector<uint32_t>& getNodes() const;
+
+		size_t getNodesCount() const;
+
+		/// @brief Get index of node that CPU belongs to in getNodes
+		/// @return 0 for unknown CPU
+		size_t getNodeIndex(uint32_t cpu) const noexcept;
+
+		~NumaTopology() = default;
+	};
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+/// @file OverlayTable.h
+/// @brief Merged key table of overlay modules chain
+
+#include <vector>
+#include <memory_resource>
+
+#include "TextLocalization.h"
+#include "WTextLocalization.h"
+#include "StringViewUtils.h"
+
+namespace localization
+{
+	class UsageProfile;
+
+	/// @brief Localized value with module(layer) it came from
+	struct LOCALIZATION_API LocalizedValue
+	{
+		/// @brief Localized value
+		std::string_view value;
+		/// @brief Name of module that provides value
+		std::string_view module;
+		/// @brief Value was taken from original language
+		bool fallback = false;
+	};
+
+	/// @brief Single key table built from chain of modules where each next module overlays previous
+	class LOCALIZATION_API OverlayTable
+	{
+	public:
+		/// @brief Module in overlays chain
+		struct LOCALIZATION_API Layer
+		{
+			/// @brief Name of module. Must be valid while OverlayTable is used
+			std::string_view name;
+			const TextLocalization* localization;
+#ifndef __LINUX__
+			const WTextLocalization* wlocalization;
+#endif
+		};
+
+	private:
+		struct Entry
+		{
+			std::string_view value;
+			size_t layer;
+		};
+
+	private:
+		using Dictionary = std::pmr::unordered_map<std::pmr::string, Entry, utility::StringViewHash, utility::StringViewEqual>;
+
+	private:
+		std::vector<Layer> layers;
+		std::pmr::unordered_map<std::pmr::string, Dictionary, utility::StringViewHash, utility::StringViewEqual> dictionaries;
+		std::string originalLanguage;
+		/// @brief Some values aren't in table because usage profile doesn't allow them
+		bool pruned;
+
+	private:
+		/// @brief Find in table or in layers if table is pruned
+		bool findEntry(std::string_view key, std::string_view language, Entry& entry) const;
+
+		Entry find(std::string_view key, std::string_view& language, bool allowOriginal) const;
+
+	public:
+		/// @brief Build merged table
+		/// @param layers Modules chain from base module to top overlay
+		/// @param resource Memory of keys and tables
+		/// @param usage Keep only values allowed by profile of layer that provides them. Other values are found in layers, so their lookups are slower
+		/// @exception std::runtime_error Empty chain or module doesn't export dictionaries functions
+		OverlayTable(std::vector<Layer>&& layers, std::pmr::memory_resource* resource = std::pmr::get_default_resource(), const UsageProfile* usage = nullptr);
+
+		OverlayTable(const OverlayTable&) = delete;
+
+		OverlayTable(OverlayTable&&) noexcept = default;
+
+		OverlayTable& operator = (const OverlayTable&) = delete;
+
+		OverlayTable& operator = (OverlayTable&&) noexcept = default;
+
+		/// @brief Get modules chain from base module to top overlay
+		const std::vector<Layer>& getLayers() const;
+
+		/// @brief Get localized text with single lookup
+		/// @param key Localization key
+		/// @param language Specific language
+		/// @param allowOriginal If can't find text for specific language try to find in original language of top overlay
+		/// @return Localized value and module it came from
+		/// @exception std::runtime_error Wrong key
+		LocalizedValue getString(std::string_view key, std::string_view language, bool allowOriginal = true) const;
+
+#ifndef __LINUX__
+		/// @brief Get localized text from layer resolved by merged table
+		/// @param key Localization key
+		/// @param language Specific language
+		/// @param allowOriginal If can't find text for specific language try to find in original language of top overlay
+		/// @return Localized value
+		/// @exception std::runtime_error Wrong key
+		std::wstring_view getWideString(std::string_view key, std::string_view language, bool allowOriginal = true) const;
+#endif
+
+		~OverlayTable() = default;
+	};
+}
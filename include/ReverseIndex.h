@@ -0,0 +1,81 @@
+#pragma once
+
+/// @file ReverseIndex.h
+/// @brief Full text search over localized values
+
+#include <vector>
+#include <memory_resource>
+
+#include "TextLocalization.h"
+#include "UsageProfile.h"
+
+namespace localization
+{
+	/// @brief Trigram index over case folded UTF-8 values of all languages of module
+	/// @details Index owns copies of keys and values, so it stays valid after module is removed.
+	/// Queries shorter than 3 bytes can't use trigrams and scan all values of language
+	class LOCALIZATION_API ReverseIndex
+	{
+	private:
+		struct Document
+		{
+			uint32_t key;
+			uint32_t valueOffset;
+			uint32_t valueSize;
+		};
+
+		/// @brief Containers get memory resource of index from languages vector
+		struct Language
+		{
+			std::pmr::string name;
+			std::pmr::vector<Document> documents;
+			/// @brief Original values followed by folded values of the same size
+			std::pmr::string values;
+			/// @brief Sorted documents indices for each trigram of folded values
+			std::pmr::unordered_map<uint32_t, std::pmr::vector<uint32_t>> postings;
+
+			using allocator_type = std::pmr::polymorphic_allocator<>;
+
+			Language(const allocator_type& allocator);
+
+			Language(Language&& other, const allocator_type& allocator);
+		};
+
+	private:
+		std::pmr::vector<std::pmr::string> keys;
+		std::pmr::vector<Language> languages;
+		size_t memoryUsage;
+
+	private:
+		void find(const Language& language, std::string_view text, std::string_view foldedText, bool ignoreCase, std::vector<uint32_t>& result) const;
+
+	public:
+		/// @brief Index all languages of module
+		/// @param localization Source module
+		/// @param resource Memory of index. Index is built in temporary containers and copied with exact sizes, so monotonic resources don't keep growth leftovers
+		/// @param usage Index only allowed languages and keys. Original language keeps keys allowed in any language
+		/// @exception std::runtime_error Module doesn't export dictionaries functions
+		ReverseIndex(const TextLocalization& localization, std::pmr::memory_resource* resource = std::pmr::get_default_resource(), const UsageProfile::Module* usage = nullptr);
+
+		ReverseIndex(const ReverseIndex&) = delete;
+
+		ReverseIndex(ReverseIndex&&) noexcept = default;
+
+		ReverseIndex& operator = (const ReverseIndex&) = delete;
+
+		ReverseIndex& operator = (ReverseIndex&&) noexcept = default;
+
+		/// @brief Find keys which values contain text
+		/// @param text Substring to find
+		/// @param language Specific language. All languages if empty
+		/// @param ignoreCase Compare case folded values
+		/// @return Sorted unique keys valid while index exists
+		/// @exception std::runtime_error Wrong language
+		std::vector<std::string_view> find(std::string_view text, std::string_view language = "", bool ignoreCase = false) const;
+
+		/// @brief Get approximate memory used by index in bytes
+		size_t getMemoryUsage() const;
+
+		~ReverseIndex() = default;
+	};
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+/// @file SharedDictionary.h
+/// @brief DictionaryImage in named POSIX shared memory for pre-fork servers
+
+#ifdef __LINUX__
+
+#include "DictionaryImage.h"
+
+namespace localization
+{
+	/// @brief Read only DictionaryImage attached from named shared memory segment
+	/// @details Loader process publishes image once. Other processes attach with single mmap and serve lookups from the same physical pages.
+	/// Segment name refers to small control segment with current generation, image itself lives in <name>.<generation> segment.
+	/// Publishing new generation never modifies mapped images, so readers can refresh at any moment
+	class LOCALIZATION_API SharedDictionary
+	{
+	private:
+		struct Mapping
+		{
+			const void* data;
+			size_t size;
+		};
+
+	private:
+		std::string name;
+		const void* control;
+		Mapping mapping;
+		/// @brief Generations replaced by refresh. Values returned from them may still be used
+		std::vector<Mapping> previousMappings;
+		DictionaryImage image;
+
+	private:
+		/// @return false if generation was already unlinked by newer publish
+		bool map(uint64_t generation);
+
+		void mapPublished();
+
+		void unmap();
+
+	public:
+		/// @brief Build image of module and publish it as new generation of segment
+		/// @param localization Source module
+		/// @param name Segment name. Must start with /
+		/// @return Published generation
+		/// @exception std::runtime_error Can't create or map segment
+		static uint64_t publish(const TextLocalization& localization, std::string_view name);
+
+		/// @brief Unlink control segment and current image segment. Attached processes keep their mappings
+		/// @param name Segment name
+		/// @return Segment existed
+		static bool remove(std::string_view name);
+
+	public:
+		/// @brief Attach to current generation of published segment
+		/// @param name Segment name. Must start with /
+		/// @exception std::runtime_error Segment doesn't exist or has wrong format
+		SharedDictionary(std::string_view name);
+
+		SharedDictionary(const SharedDictionary&) = delete;
+
+		SharedDictionary& operator = (const SharedDictionary&) = delete;
+
+		/// @brief Attach to newer generation if it was published. Not thread safe. Previous generation stays mapped until releasePrevious, so values from it stay valid
+		/// @return Generation was changed
+		/// @exception std::runtime_error Can't map new generation
+		bool refresh();
+
+		/// @brief Unmap generations replaced by refresh. Not thread safe, values from them become invalid
+		/// @return Unmapped bytes
+		size_t releasePrevious();
+
+		/// @brief Get mapped bytes of current and previous generations
+		size_t getMemoryUsage() const;
+
+		/// @brief Get currently mapped generation
+		uint64_t getGeneration() const;
+
+		/// @brief Get latest published generation
+		uint64_t getPublishedGeneration() const;
+
+		/// @brief Get mapped image
+		const DictionaryImage& getImage() const;
+
+		/// @brief Get localized text
+		/// @param key Localization key
+		/// @param language Specific language. Original language if empty
+		/// @param allowOriginal If can't find text for specific language try to find in original language
+		/// @return Localized value
+		/// @exception std::runtime_error Wrong key
+		std::string_view getString(std::string_view key, std::string_view language = "", bool allowOriginal = true) const;
+
+		~SharedDictionary();
+	};
+}
+
+#endif
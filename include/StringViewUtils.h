@@ -1,6 +1,8 @@
 #pragma once
 
+#include <string>
 #include <string_view>
+#include <cstdint>
 
 #include "LocalizationConstants.h"
 
@@ -19,4 +21,27 @@ namespace localization::utility
 
 		bool operator ()(std::string_view left, std::string_view right) const;
 	};
+
+	/// @brief FNV-1a hash. Unlike std::hash result is the same in all processes and builds
+	inline constexpr uint64_t stableHash(std::string_view value)
+	{
+		uint64_t result = 14695981039346656037ULL;
+
+		for (char symbol : value)
+		{
+			result = (result ^ static_cast<uint8_t>(symbol)) * 1099511628211ULL;
+		}
+
+		return result;
+	}
+
+	/// @brief Lower case single symbol of UTF-8 string
+	/// @param value UTF-8 string
+	/// @param index Start of symbol
+	/// @param result Buffer for at least 2 bytes
+	/// @return Number of bytes read from value and written to result
+	LOCALIZATION_API size_t foldSymbol(std::string_view value, size_t index, char* result);
+
+	/// @brief Lower case ASCII, Latin-1, Greek and Cyrillic letters of UTF-8 string. Folded string has the same size
+	LOCALIZATION_API std::string foldCase(std::string_view value);
 }
@@ -9,4 +9,7 @@ namespace localization
 {
 	/// @brief TextLocalization with string
 	using TextLocalization = localization::BaseTextLocalization<char>;
+
+	/// @brief Instantiated in library
+	extern template class BaseTextLocalization<char>;
 }
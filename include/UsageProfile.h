@@ -0,0 +1,85 @@
+#pragma once
+
+/// @file UsageProfile.h
+/// @brief Languages and keys that deployment actually serves
+
+#include <map>
+#include <set>
+#include <string>
+#include <optional>
+#include <filesystem>
+
+#include "LocalizationConstants.h"
+
+namespace localization
+{
+	/// @brief Set of (module, language, key) triples and whole languages. Recorded by MultiLocalizationManager::startUsageRecording or written by hand as allow-list
+	/// @details Text file with tab separated line per entry: "module	language	key" keeps single key, "module	language" keeps all keys of language.
+	/// Module * applies to all modules. Empty lines and lines starting with # are ignored
+	class LOCALIZATION_API UsageProfile
+	{
+	public:
+		/// @brief Module name that matches all modules
+		static constexpr std::string_view anyModule = "*";
+
+	public:
+		/// @brief Languages and keys allowed for single module
+		struct LOCALIZATION_API Module
+		{
+			/// @brief Languages with all keys
+			std::set<std::string, std::less<>> languages;
+			/// @brief Separate keys of language
+			std::map<std::string, std::set<std::string, std::less<>>, std::less<>> keys;
+
+			/// @brief Language has any allowed key
+			bool hasLanguage(std::string_view language) const;
+
+			/// @brief Key is allowed in language
+			bool isKeyAllowed(std::string_view language, std::string_view key) const;
+
+			/// @brief Key is allowed in any language. Original language keeps such keys for fallback
+			bool isKeyUsed(std::string_view key) const;
+
+			bool operator == (const Module& other) const = default;
+		};
+
+	private:
+		std::map<std::string, Module, std::less<>> modules;
+
+	public:
+		/// @brief Load profile file
+		/// @param pathToProfile Path to file written by save or by hand
+		/// @exception std::runtime_error Can't open file or wrong line
+		static UsageProfile load(const std::filesystem::path& pathToProfile);
+
+	public:
+		UsageProfile() = default;
+
+		/// @brief Write profile in sorted order. Keys must not contain tabs or line breaks
+		/// @param pathToProfile Output file. Overwritten
+		/// @exception std::runtime_error Can't open file
+		void save(const std::filesystem::path& pathToProfile) const;
+
+		/// @brief Allow all keys of language
+		/// @param module Module name or anyModule
+		void addLanguage(std::string_view module, std::string_view language);
+
+		/// @brief Allow single key of language
+		/// @param module Module name or anyModule
+		void addKey(std::string_view module, std::string_view language, std::string_view key);
+
+		/// @brief Get entries of module merged with anyModule entries
+		/// @return Empty if profile doesn't restrict module
+		std::optional<Module> getModule(std::string_view module) const;
+
+		/// @brief Get entries of all modules as written
+		const std::map<std::string, Module, std::less<>>& getModules() const;
+
+		/// @brief Get number of allowed keys and languages
+		size_t size() const;
+
+		bool empty() const;
+
+		~UsageProfile() = default;
+	};
+}
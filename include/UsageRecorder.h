@@ -0,0 +1,53 @@
+#pragma once
+
+/// @file UsageRecorder.h
+/// @brief Lock free record of keys resolved from single module
+
+#include <atomic>
+#include <memory>
+#include <memory_resource>
+
+#include "DictionaryImage.h"
+
+namespace localization
+{
+	/// @brief Bit per DictionaryImage slot of module. Set bits mark (language, key) pairs resolved at least once
+	/// @details Recording is single relaxed fetch_or after image lookup and never blocks. Bits that are already set are only read, so hot keys don't bounce cache lines between cores
+	class LOCALIZATION_API UsageRecorder
+	{
+	private:
+		std::pmr::vector<std::byte> image;
+		DictionaryImage index;
+		std::pmr::vector<std::atomic<uint64_t>> bits;
+
+	public:
+		/// @brief Build slots index of all languages of module
+		/// @param localization Source module
+		/// @param resource Memory of slots index and bits
+		/// @exception std::runtime_error Module doesn't export dictionaries functions
+		UsageRecorder(const TextLocalization& localization, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+		UsageRecorder(const UsageRecorder&) = delete;
+
+		UsageRecorder& operator = (const UsageRecorder&) = delete;
+
+		/// @brief Mark key as resolved. Thread safe
+		/// @param key Original(not normalized) key
+		/// @param language Language of returned value
+		/// @return Key exists in language
+		bool record(std::string_view key, std::string_view language) noexcept;
+
+		/// @brief Get original language of module
+		std::string_view getOriginalLanguage() const;
+
+		/// @brief Add resolved keys to profile. Thread safe, concurrent records may be missed
+		/// @param module Module name in profile
+		/// @param profile Output profile
+		void collect(std::string_view module, UsageProfile& profile) const;
+
+		/// @brief Get number of resolved (language, key) pairs. Thread safe
+		size_t getRecordedCount() const;
+
+		~UsageRecorder() = default;
+	};
+}
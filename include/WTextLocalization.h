@@ -5,11 +5,15 @@
 
 #ifndef __LINUX__
 
+#include <memory_resource>
+
 #include "TextLocalization.h"
 #include "StringViewUtils.h"
 
 namespace localization
 {
+	class UsageProfile;
+
 	/// @brief TextLocalization with std::wstring
 	using WTextLocalization = localization::BaseTextLocalization<wchar_t>;
 
@@ -18,19 +22,44 @@ namespace localization
 	class LOCALIZATION_API BaseTextLocalization<wchar_t> final
 	{
 	private:
-		std::unordered_map<std::string, std::unordered_map<std::string, std::wstring, utility::StringViewHash, utility::StringViewEqual>, utility::StringViewHash, utility::StringViewEqual> dictionaries;
+		using Dictionary = std::pmr::unordered_map<std::pmr::string, std::pmr::wstring, utility::StringViewHash, utility::StringViewEqual>;
+		using Dictionaries = std::pmr::unordered_map<std::pmr::string, Dictionary, utility::StringViewHash, utility::StringViewEqual>;
+
+		/// @brief Values missing in pruned dictionaries, converted on first lookup. Defined in src/WTextLocalization.cpp so this header doesn't include <mutex>
+		struct Converted;
+
+	private:
+		Dictionaries dictionaries;
 		std::string originalLanguage;
 		std::string language;
 		std::filesystem::path pathToModule;
-		HMODULE handle;
+		std::unordered_map<std::string, LocaleData, utility::StringViewHash, utility::StringViewEqual> localeData;
+		/// @brief Set if dictionaries are pruned by usage profile
+		std::unique_ptr<Converted> converted;
+		/// @brief HMODULE of converted module
+		void* handle;
+
+	private:
+		/// @brief Published by initialize after default module is completely converted
+		static std::atomic<WTextLocalization*> instance;
 
 	private:
-		void convertLocalization(const TextLocalization& localizationModule);
+		/// @param usage Convert only allowed languages and keys. Original language keeps keys allowed in any language
+		/// @param moduleName Name of module in usage
+		void convertLocalization(const TextLocalization& localizationModule, const UsageProfile* usage = nullptr, std::string_view moduleName = "");
+
+		/// @brief Find in dictionaries or convert value missing in pruned dictionaries
+		/// @return nullptr if key doesn't exist
+		/// @exception std::runtime_error Wrong language
+		const std::pmr::wstring* find(std::string_view key, std::string_view language) const;
 
 	private:
 		BaseTextLocalization(std::string_view localizationModule);
 
-		BaseTextLocalization(const TextLocalization& localizationModule);
+		/// @param resource Memory of converted dictionaries
+		/// @param usage Convert only allowed languages and keys, other values are converted on first lookup. Module must stay loaded while dictionaries are used then
+		/// @param moduleName Name of module in usage
+		BaseTextLocalization(const TextLocalization& localizationModule, std::pmr::memory_resource* resource = std::pmr::get_default_resource(), const UsageProfile* usage = nullptr, std::string_view moduleName = "");
 
 		BaseTextLocalization(const WTextLocalization&) = delete;
 
@@ -38,16 +67,27 @@ namespace localization
 
 		WTextLocalization& operator = (const WTextLocalization&) = delete;
 
+		/// @brief Dictionaries take memory resource of other dictionaries
 		WTextLocalization& operator = (WTextLocalization&& other) noexcept;
 
-		~BaseTextLocalization() = default;
+		~BaseTextLocalization();
 
 	public:
-		/// @brief Exception can be thrown on first call
+		/// @brief Convert default localization module once. Thread safe, concurrent callers wait until first call finishes. If converting throws next call tries again
+		/// @return Singleton instance
+		/// @exception std::runtime_error Can't find Localization.dll or something inside Localization.dll
+		static BaseTextLocalization& initialize();
+
+		/// @brief Calls initialize on first use
 		/// @return Singleton instance
 		/// @exception std::runtime_error Can't find Localization.dll or something inside Localization.dll
 		static BaseTextLocalization& get();
 
+		/// @brief Singleton instance without initialization check. Single load of published pointer
+		/// @return Singleton instance
+		/// @warning initialize or get must successfully finish before
+		static BaseTextLocalization& getInitialized() noexcept;
+
 		/// @brief Change localization
 		/// @param language Language key
 		/// @exception std::runtime_error Wrong language
@@ -64,6 +104,16 @@ namespace localization
 		/// @brief Get path to used module
 		const std::filesystem::path& getPathToModule() const;
 
+		/// @brief Get number, currency and date formatting data
+		/// @param language Specific language
+		/// @return LocaleData
+		/// @exception std::runtime_error Wrong language
+		const LocaleData& getLocaleData(std::string_view language) const;
+
+		/// @brief Get number, currency and date formatting data of current language
+		/// @return LocaleData
+		const LocaleData& getLocaleData() const;
+
 		/// @brief Get localized text
 		/// @param key Localization key
 		/// @param language Specific language
@@ -83,6 +133,21 @@ namespace localization
 		friend struct LocalizationHolder;
 		friend std::unique_ptr<WTextLocalization>::deleter_type;
 	};
+
+	inline WTextLocalization& BaseTextLocalization<wchar_t>::get()
+	{
+		if (WTextLocalization* result = instance.load(std::memory_order_acquire)) [[likely]]
+		{
+			return *result;
+		}
+
+		return WTextLocalization::initialize();
+	}
+
+	inline WTextLocalization& BaseTextLocalization<wchar_t>::getInitialized() noexcept
+	{
+		return *instance.load(std::memory_order_acquire);
+	}
 }
 
 #endif
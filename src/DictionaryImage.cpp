@@ -0,0 +1,385 @@
+#include "DictionaryImage.h"
+
+#include <bit>
+#include <cstring>
+#include <limits>
+#include <algorithm>
+#include <format>
+
+namespace
+{
+	/// @brief LOCIMAGE
+	constexpr uint64_t imageMagic = 0x4547414D49434F4CULL;
+
+	struct StringReference
+	{
+		uint32_t offset;
+		uint32_t size;
+	};
+
+	struct Header
+	{
+		uint64_t magic;
+		uint32_t version;
+		uint32_t languagesCount;
+		uint64_t generation;
+		uint64_t size;
+		StringReference originalLanguage;
+	};
+
+	struct Language
+	{
+		StringReference name;
+		uint32_t keysCount;
+		uint32_t capacity;
+		uint64_t tableOffset;
+	};
+
+	/// @brief Empty if key.offset is 0
+	struct Slot
+	{
+		uint64_t hash;
+		StringReference key;
+		StringReference value;
+	};
+
+	std::string_view toView(const std::byte* data, StringReference reference)
+	{
+		return std::string_view(reinterpret_cast<const char*>(data + reference.offset), reference.size);
+	}
+
+	const Language* findLanguage(const std::byte* data, std::string_view language)
+	{
+		const Header* header = reinterpret_cast<const Header*>(data);
+		const Language* languages = reinterpret_cast<const Language*>(data + sizeof(Header));
+
+		for (uint32_t i = 0; i < header->languagesCount; i++)
+		{
+			if (toView(data, languages[i].name) == language)
+			{
+				return languages + i;
+			}
+		}
+
+		return nullptr;
+	}
+}
+
+namespace localization
+{
+	std::vector<std::byte> DictionaryImage::build(const TextLocalization& localization, uint64_t generation, const UsageProfile::Module* usage)
+	{
+		struct Dictionary
+		{
+			std::string language;
+			std::vector<std::pair<std::string, std::string_view>> entries;
+		};
+
+		std::vector<Dictionary> dictionaries;
+		std::string pool;
+		size_t tablesSize = 0;
+		std::string_view originalLanguage = localization.getOriginalLanguage();
+
+		for (std::string& language : localization.getLanguages())
+		{
+			bool isOriginal = language == originalLanguage;
+
+			// Excluded languages aren't decoded at all
+			if (usage && !isOriginal && !usage->hasLanguage(language))
+			{
+				continue;
+			}
+
+			Dictionary& dictionary = dictionaries.emplace_back(std::move(language));
+
+			localization.forEachString
+			(
+				dictionary.language,
+				[&dictionary, usage, isOriginal](std::string_view key, std::string_view value)
+				{
+					if (usage && !usage->isKeyAllowed(dictionary.language, key) && !(isOriginal && usage->isKeyUsed(key)))
+					{
+						return;
+					}
+
+					dictionary.entries.emplace_back(key, value);
+				}
+			);
+
+			if (dictionary.entries.size())
+			{
+				tablesSize += std::bit_ceil(dictionary.entries.size() * 2) * sizeof(Slot);
+			}
+		}
+
+		const size_t languagesOffset = sizeof(Header);
+		const size_t tablesOffset = languagesOffset + dictionaries.size() * sizeof(Language);
+		const size_t poolOffset = tablesOffset + tablesSize;
+
+		auto addString = [&pool, poolOffset](std::string_view value) -> StringReference
+			{
+				StringReference result = { static_cast<uint32_t>(poolOffset + pool.size()), static_cast<uint32_t>(value.size()) };
+
+				pool.append(value);
+				pool.push_back('\0');
+
+				return result;
+			};
+
+		std::vector<Language> languages;
+		std::vector<Slot> slots(tablesSize / sizeof(Slot));
+		Header header = {};
+		size_t tableOffset = tablesOffset;
+
+		header.magic = imageMagic;
+		header.version = version;
+		header.languagesCount = static_cast<uint32_t>(dictionaries.size());
+		header.generation = generation;
+		header.originalLanguage = addString(originalLanguage);
+
+		for (const Dictionary& dictionary : dictionaries)
+		{
+			Language& language = languages.emplace_back();
+
+			language.name = addString(dictionary.language);
+			language.keysCount = static_cast<uint32_t>(dictionary.entries.size());
+			language.capacity = dictionary.entries.size() ? static_cast<uint32_t>(std::bit_ceil(dictionary.entries.size() * 2)) : 0;
+			language.tableOffset = tableOffset;
+
+			Slot* table = slots.data() + (tableOffset - tablesOffset) / sizeof(Slot);
+
+			for (const auto& [key, value] : dictionary.entries)
+			{
+				uint64_t hash = utility::stableHash(key);
+				uint32_t index = static_cast<uint32_t>(hash) & (language.capacity - 1);
+
+				while (table[index].key.offset)
+				{
+					index = (index + 1) & (language.capacity - 1);
+				}
+
+				table[index] = { hash, addString(key), addString(value) };
+			}
+
+			tableOffset += language.capacity * sizeof(Slot);
+		}
+
+		header.size = (poolOffset + pool.size() + alignof(Slot) - 1) & ~(alignof(Slot) - 1);
+
+		if (header.size > std::numeric_limits<uint32_t>::max())
+		{
+			throw std::runtime_error(std::format("Dictionary image of {} is too big", localization.getPathToModule().string()));
+		}
+
+		std::vector<std::byte> result(header.size);
+
+		std::memcpy(result.data(), &header, sizeof(header));
+		std::memcpy(result.data() + languagesOffset, languages.data(), languages.size() * sizeof(Language));
+		std::memcpy(result.data() + tablesOffset, slots.data(), tablesSize);
+		std::memcpy(result.data() + poolOffset, pool.data(), pool.size());
+
+		return result;
+	}
+
+	bool DictionaryImage::isValid(const void* data, size_t size)
+	{
+		if (!data || size < sizeof(Header))
+		{
+			return false;
+		}
+
+		const Header* header = static_cast<const Header*>(data);
+
+		return header->magic == imageMagic && header->version == version && header->size <= size;
+	}
+
+	DictionaryImage::DictionaryImage(const void* data) :
+		data(static_cast<const std::byte*>(data))
+	{
+
+	}
+
+	const void* DictionaryImage::getData() const
+	{
+		return data;
+	}
+
+	size_t DictionaryImage::getSize() const
+	{
+		return reinterpret_cast<const Header*>(data)->size;
+	}
+
+	uint64_t DictionaryImage::getGeneration() const
+	{
+		return reinterpret_cast<const Header*>(data)->generation;
+	}
+
+	std::string_view DictionaryImage::getOriginalLanguage() const
+	{
+		return toView(data, reinterpret_cast<const Header*>(data)->originalLanguage);
+	}
+
+	std::vector<std::string_view> DictionaryImage::getLanguages() const
+	{
+		const Header* header = reinterpret_cast<const Header*>(data);
+		const Language* languages = reinterpret_cast<const Language*>(data + sizeof(Header));
+		std::vector<std::string_view> result;
+
+		result.reserve(header->languagesCount);
+
+		for (uint32_t i = 0; i < header->languagesCount; i++)
+		{
+			result.push_back(toView(data, languages[i].name));
+		}
+
+		return result;
+	}
+
+	const char* DictionaryImage::find(std::string_view key, std::string_view language) const noexcept
+	{
+		const Language* dictionary = findLanguage(data, language);
+
+		if (!dictionary || !dictionary->capacity)
+		{
+			return nullptr;
+		}
+
+		const Slot* table = reinterpret_cast<const Slot*>(data + dictionary->tableOffset);
+		uint64_t hash = utility::stableHash(key);
+		uint32_t mask = dictionary->capacity - 1;
+
+		for (uint32_t index = static_cast<uint32_t>(hash) & mask; table[index].key.offset; index = (index + 1) & mask)
+		{
+			if (table[index].hash == hash && toView(data, table[index].key) == key)
+			{
+				return reinterpret_cast<const char*>(data + table[index].value.offset);
+			}
+		}
+
+		return nullptr;
+	}
+
+	std::string_view DictionaryImage::getString(std::string_view key, std::string_view language, bool allowOriginal) const
+	{
+		if (const char* result = this->find(key, language))
+		{
+			return result;
+		}
+
+		if (!allowOriginal)
+		{
+			throw std::runtime_error(std::format(R"(Can't find key "{}" for {})", key, language));
+		}
+
+		std::string_view originalLanguage = this->getOriginalLanguage();
+
+		if (const char* result = this->find(key, originalLanguage))
+		{
+			return result;
+		}
+
+		throw std::runtime_error(std::format(R"(Can't find key "{}" for {}, also can't find in original language {})", key, language, originalLanguage));
+	}
+
+	size_t DictionaryImage::getSlotsCount() const
+	{
+		const Header* header = reinterpret_cast<const Header*>(data);
+		const Language* languages = reinterpret_cast<const Language*>(data + sizeof(Header));
+		size_t result = 0;
+
+		for (uint32_t i = 0; i < header->languagesCount; i++)
+		{
+			result += languages[i].capacity;
+		}
+
+		return result;
+	}
+
+	size_t DictionaryImage::findSlot(std::string_view key, std::string_view language) const noexcept
+	{
+		const Language* dictionary = findLanguage(data, language);
+
+		if (!dictionary || !dictionary->capacity)
+		{
+			return npos;
+		}
+
+		// Tables are laid out in languages order right after languages array
+		const Header* header = reinterpret_cast<const Header*>(data);
+		const size_t tablesOffset = sizeof(Header) + header->languagesCount * sizeof(Language);
+		const Slot* table = reinterpret_cast<const Slot*>(data + dictionary->tableOffset);
+		uint64_t hash = utility::stableHash(key);
+		uint32_t mask = dictionary->capacity - 1;
+
+		for (uint32_t index = static_cast<uint32_t>(hash) & mask; table[index].key.offset; index = (index + 1) & mask)
+		{
+			if (table[index].hash == hash && toView(data, table[index].key) == key)
+			{
+				return (dictionary->tableOffset - tablesOffset) / sizeof(Slot) + index;
+			}
+		}
+
+		return npos;
+	}
+
+	std::pair<std::string_view, std::string_view> DictionaryImage::getSlot(size_t slot) const
+	{
+		const Header* header = reinterpret_cast<const Header*>(data);
+		const Language* languages = reinterpret_cast<const Language*>(data + sizeof(Header));
+		size_t index = slot;
+
+		for (uint32_t i = 0; i < header->languagesCount; i++)
+		{
+			if (index < languages[i].capacity)
+			{
+				const Slot& result = reinterpret_cast<const Slot*>(data + languages[i].tableOffset)[index];
+
+				return { toView(data, languages[i].name), result.key.offset ? toView(data, result.key) : std::string_view() };
+			}
+
+			index -= languages[i].capacity;
+		}
+
+		throw std::out_of_range(std::format("Wrong slot {}", slot));
+	}
+
+	DictionaryImage::ProbeStatistics DictionaryImage::getProbeStatistics(std::string_view language) const
+	{
+		const Language* dictionary = findLanguage(data, language);
+
+		if (!dictionary)
+		{
+			throw std::runtime_error(std::format(R"(Wrong language value "{}")", language));
+		}
+
+		ProbeStatistics result = { dictionary->keysCount, dictionary->capacity, 0.0, 0, 0 };
+		const Slot* table = reinterpret_cast<const Slot*>(data + dictionary->tableOffset);
+		uint64_t totalProbeLength = 0;
+
+		for (uint32_t index = 0; index < dictionary->capacity; index++)
+		{
+			if (!table[index].key.offset)
+			{
+				continue;
+			}
+
+			size_t probeLength = ((index - static_cast<uint32_t>(table[index].hash)) & (dictionary->capacity - 1)) + 1;
+
+			totalProbeLength += probeLength;
+			result.maxProbeLength = std::max(result.maxProbeLength, probeLength);
+			result.collisions += probeLength > 1;
+		}
+
+		if (result.keys)
+		{
+			result.averageProbeLength = static_cast<double>(totalProbeLength) / result.keys;
+		}
+
+		return result;
+	}
+
+	DictionaryImage::operator bool() const
+	{
+		return data;
+	}
+}
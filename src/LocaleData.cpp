@@ -0,0 +1,447 @@
+#include "LocaleData.h"
+
+#include <charconv>
+#include <cstring>
+#include <cmath>
+
+namespace
+{
+	struct DefaultLocale
+	{
+		std::string_view language;
+		const char* decimalSeparator;
+		const char* groupSeparator;
+		uint8_t primaryGroupSize;
+		uint8_t secondaryGroupSize;
+		const char* currencyPattern;
+		const char* datePattern;
+		const char* timePattern;
+	};
+
+	// UTF-8: C2 A0 - no-break space, E2 80 AF - narrow no-break space, C2 A4 - currency sign
+	constexpr DefaultLocale defaultLocales[] =
+	{
+		{ "en", ".", ",", 3, 3, "\xC2\xA4#", "MM/dd/yyyy", "h:mm a" },
+		{ "ru", ",", "\xC2\xA0", 3, 3, "#\xC2\xA0\xC2\xA4", "dd.MM.yyyy", "HH:mm" },
+		{ "uk", ",", "\xC2\xA0", 3, 3, "#\xC2\xA0\xC2\xA4", "dd.MM.yyyy", "HH:mm" },
+		{ "be", ",", "\xC2\xA0", 3, 3, "#\xC2\xA0\xC2\xA4", "dd.MM.yyyy", "HH:mm" },
+		{ "kk", ",", "\xC2\xA0", 3, 3, "#\xC2\xA0\xC2\xA4", "dd.MM.yyyy", "HH:mm" },
+		{ "pl", ",", "\xC2\xA0", 3, 3, "#\xC2\xA0\xC2\xA4", "dd.MM.yyyy", "HH:mm" },
+		{ "de", ",", ".", 3, 3, "#\xC2\xA0\xC2\xA4", "dd.MM.yyyy", "HH:mm" },
+		{ "fr", ",", "\xE2\x80\xAF", 3, 3, "#\xC2\xA0\xC2\xA4", "dd/MM/yyyy", "HH:mm" },
+		{ "es", ",", ".", 3, 3, "#\xC2\xA0\xC2\xA4", "dd/MM/yyyy", "H:mm" },
+		{ "it", ",", ".", 3, 3, "#\xC2\xA0\xC2\xA4", "dd/MM/yyyy", "HH:mm" },
+		{ "pt", ",", ".", 3, 3, "\xC2\xA4\xC2\xA0#", "dd/MM/yyyy", "HH:mm" },
+		{ "tr", ",", ".", 3, 3, "\xC2\xA4#", "dd.MM.yyyy", "HH:mm" },
+		{ "ja", ".", ",", 3, 3, "\xC2\xA4#", "yyyy/MM/dd", "H:mm" },
+		{ "zh", ".", ",", 3, 3, "\xC2\xA4#", "yyyy/MM/dd", "HH:mm" },
+		{ "ko", ".", ",", 3, 3, "\xC2\xA4#", "yyyy. MM. dd.", "a h:mm" },
+		{ "hi", ".", ",", 3, 2, "\xC2\xA4#", "dd/MM/yyyy", "h:mm a" }
+	};
+
+	constexpr std::string_view currencySign = "\xC2\xA4";
+
+	class BufferWriter
+	{
+	private:
+		char* begin;
+		char* current;
+		char* end;
+		bool overflow;
+
+	public:
+		BufferWriter(std::span<char> buffer) :
+			begin(buffer.data()),
+			current(buffer.data()),
+			end(buffer.data() + buffer.size()),
+			overflow(false)
+		{
+
+		}
+
+		void write(std::string_view value)
+		{
+			if (overflow || static_cast<size_t>(end - current) < value.size())
+			{
+				overflow = true;
+
+				return;
+			}
+
+			std::memcpy(current, value.data(), value.size());
+
+			current += value.size();
+		}
+
+		void write(uint64_t value, size_t minDigits)
+		{
+			char digits[20];
+			auto [last, _] = std::to_chars(digits, digits + sizeof(digits), value);
+
+			for (size_t size = last - digits; size < minDigits; size++)
+			{
+				this->write("0");
+			}
+
+			this->write(std::string_view(digits, last));
+		}
+
+		std::string_view result() const
+		{
+			return overflow ? std::string_view() : std::string_view(begin, current);
+		}
+	};
+
+	void writeGrouped(BufferWriter& writer, const localization::LocaleData& data, std::string_view digits)
+	{
+		size_t primary = data.primaryGroupSize;
+
+		if (!primary || digits.size() <= primary)
+		{
+			writer.write(digits);
+
+			return;
+		}
+
+		size_t secondary = data.secondaryGroupSize ? data.secondaryGroupSize : primary;
+		size_t rest = digits.size() - primary;
+		size_t position = rest % secondary ? rest % secondary : secondary;
+
+		writer.write(digits.substr(0, position));
+
+		while (position < rest)
+		{
+			writer.write(data.groupSeparator);
+			writer.write(digits.substr(position, secondary));
+
+			position += secondary;
+		}
+
+		writer.write(data.groupSeparator);
+		writer.write(digits.substr(rest));
+	}
+
+	/// @return Number is negative and isn't rounded to zero
+	bool toFixed(double value, int precision, char* first, char* last, std::string_view& integerPart, std::string_view& fractionalPart)
+	{
+		auto [end, error] = std::to_chars(first, last, std::fabs(value), std::chars_format::fixed, precision);
+
+		if (error != std::errc())
+		{
+			return false;
+		}
+
+		std::string_view number(first, end);
+		size_t point = number.find('.');
+
+		integerPart = number.substr(0, point);
+		fractionalPart = point == std::string_view::npos ? std::string_view() : number.substr(point + 1);
+
+		return std::signbit(value) && number.find_first_not_of("0.") != std::string_view::npos;
+	}
+
+	void writeDecimal(BufferWriter& writer, const localization::LocaleData& data, std::string_view integerPart, std::string_view fractionalPart)
+	{
+		if (integerPart.find_first_not_of("0123456789") != std::string_view::npos)
+		{
+			// inf or nan
+			writer.write(integerPart);
+
+			return;
+		}
+
+		writeGrouped(writer, data, integerPart);
+
+		if (fractionalPart.size())
+		{
+			writer.write(data.decimalSeparator);
+			writer.write(fractionalPart);
+		}
+	}
+
+	void writePattern(BufferWriter& writer, const localization::LocaleData& data, std::string_view pattern, int year, unsigned month, unsigned day, int64_t hours, int64_t minutes, int64_t seconds)
+	{
+		for (size_t i = 0; i < pattern.size();)
+		{
+			char symbol = pattern[i];
+			size_t count = 1;
+
+			if (symbol == '\'')
+			{
+				size_t close = pattern.find('\'', i + 1);
+
+				if (close == std::string_view::npos)
+				{
+					close = pattern.size();
+				}
+
+				writer.write(close == i + 1 ? "'" : pattern.substr(i + 1, close - i - 1));
+
+				i = close + 1;
+
+				continue;
+			}
+
+			while (i + count < pattern.size() && pattern[i + count] == symbol)
+			{
+				count++;
+			}
+
+			switch (symbol)
+			{
+			case 'd':
+				writer.write(day, count);
+
+				break;
+
+			case 'M':
+				writer.write(month, count);
+
+				break;
+
+			case 'y':
+				if (year < 0)
+				{
+					writer.write("-");
+				}
+
+				writer.write(count == 2 ? std::abs(year) % 100 : std::abs(year), count);
+
+				break;
+
+			case 'H':
+				writer.write(hours, count);
+
+				break;
+
+			case 'h':
+				writer.write(hours % 12 ? hours % 12 : 12, count);
+
+				break;
+
+			case 'm':
+				writer.write(minutes, count);
+
+				break;
+
+			case 's':
+				writer.write(seconds, count);
+
+				break;
+
+			case 'a':
+				writer.write(hours < 12 ? data.amMarker : data.pmMarker);
+
+				break;
+
+			default:
+				writer.write(pattern.substr(i, count));
+			}
+
+			i += count;
+		}
+	}
+}
+
+namespace localization
+{
+	LocaleData::LocaleData(std::string_view language) :
+		amMarker("AM"),
+		pmMarker("PM")
+	{
+		const DefaultLocale* locale = defaultLocales;
+
+		language = language.substr(0, language.find_first_of("_-"));
+
+		for (const DefaultLocale& defaultLocale : defaultLocales)
+		{
+			if (defaultLocale.language == language)
+			{
+				locale = &defaultLocale;
+
+				break;
+			}
+		}
+
+		decimalSeparator = locale->decimalSeparator;
+		groupSeparator = locale->groupSeparator;
+		primaryGroupSize = locale->primaryGroupSize;
+		secondaryGroupSize = locale->secondaryGroupSize;
+		currencyPattern = locale->currencyPattern;
+		datePattern = locale->datePattern;
+		timePattern = locale->timePattern;
+	}
+
+	bool LocaleData::setValue(std::string_view key, std::string_view value)
+	{
+		if (key == locale::decimalSeparatorKey)
+		{
+			decimalSeparator = value;
+		}
+		else if (key == locale::groupSeparatorKey)
+		{
+			groupSeparator = value;
+		}
+		else if (key == locale::groupingKey)
+		{
+			unsigned int primary = 0;
+			unsigned int secondary = 0;
+			auto [next, _] = std::from_chars(value.data(), value.data() + value.size(), primary);
+
+			secondary = primary;
+
+			if (next != value.data() + value.size() && *next == ';')
+			{
+				std::from_chars(next + 1, value.data() + value.size(), secondary);
+			}
+
+			primaryGroupSize = static_cast<uint8_t>(primary);
+			secondaryGroupSize = static_cast<uint8_t>(secondary);
+		}
+		else if (key == locale::currencyPatternKey)
+		{
+			currencyPattern = value;
+		}
+		else if (key == locale::datePatternKey)
+		{
+			datePattern = value;
+		}
+		else if (key == locale::timePatternKey)
+		{
+			timePattern = value;
+		}
+		else if (key == locale::amMarkerKey)
+		{
+			amMarker = value;
+		}
+		else if (key == locale::pmMarkerKey)
+		{
+			pmMarker = value;
+		}
+		else
+		{
+			return false;
+		}
+
+		return true;
+	}
+
+	std::string_view LocaleData::formatInteger(std::span<char> buffer, int64_t value) const
+	{
+		BufferWriter writer(buffer);
+		char digits[20];
+		uint64_t absolute = value < 0 ? 0 - static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+		auto [last, _] = std::to_chars(digits, digits + sizeof(digits), absolute);
+
+		if (value < 0)
+		{
+			writer.write("-");
+		}
+
+		writeGrouped(writer, *this, std::string_view(digits, last));
+
+		return writer.result();
+	}
+
+	std::string_view LocaleData::formatDecimal(std::span<char> buffer, double value, int precision) const
+	{
+		BufferWriter writer(buffer);
+		char number[512];
+		std::string_view integerPart;
+		std::string_view fractionalPart;
+
+		if (toFixed(value, precision, number, number + sizeof(number), integerPart, fractionalPart))
+		{
+			writer.write("-");
+		}
+
+		if (integerPart.empty())
+		{
+			return {};
+		}
+
+		writeDecimal(writer, *this, integerPart, fractionalPart);
+
+		return writer.result();
+	}
+
+	std::string_view LocaleData::formatCurrency(std::span<char> buffer, double value, std::string_view symbol, int precision) const
+	{
+		BufferWriter writer(buffer);
+		char number[512];
+		std::string_view integerPart;
+		std::string_view fractionalPart;
+		std::string_view pattern = currencyPattern;
+
+		if (toFixed(value, precision, number, number + sizeof(number), integerPart, fractionalPart))
+		{
+			writer.write("-");
+		}
+
+		if (integerPart.empty())
+		{
+			return {};
+		}
+
+		while (pattern.size())
+		{
+			if (pattern.front() == '#')
+			{
+				writeDecimal(writer, *this, integerPart, fractionalPart);
+
+				pattern.remove_prefix(1);
+			}
+			else if (pattern.starts_with(currencySign))
+			{
+				writer.write(symbol);
+
+				pattern.remove_prefix(currencySign.size());
+			}
+			else
+			{
+				writer.write(pattern.substr(0, 1));
+
+				pattern.remove_prefix(1);
+			}
+		}
+
+		return writer.result();
+	}
+
+	std::string_view LocaleData::formatDate(std::span<char> buffer, const std::chrono::year_month_day& date) const
+	{
+		BufferWriter writer(buffer);
+
+		writePattern
+		(
+			writer,
+			*this,
+			datePattern,
+			static_cast<int>(date.year()),
+			static_cast<unsigned>(date.month()),
+			static_cast<unsigned>(date.day()),
+			0, 0, 0
+		);
+
+		return writer.result();
+	}
+
+	std::string_view LocaleData::formatTime(std::span<char> buffer, std::chrono::seconds time) const
+	{
+		BufferWriter writer(buffer);
+		std::chrono::hh_mm_ss<std::chrono::seconds> timeOfDay(time);
+
+		writePattern
+		(
+			writer,
+			*this,
+			timePattern,
+			0, 0, 0,
+			timeOfDay.hours().count(),
+			timeOfDay.minutes().count(),
+			timeOfDay.seconds().count()
+		);
+
+		return writer.result();
+	}
+}
@@ -0,0 +1,47 @@
+module;
+
+#include "LocalizationLookup.h"
+#include "MultiLocalizationManager.h"
+#include "DictionaryImage.h"
+#include "LookupTracer.h"
+#include "ReverseIndex.h"
+#ifdef __LINUX__
+#include "SharedDictionary.h"
+#endif
+
+/// @brief Optional C++20 module with public API. Built with LOCALIZATION_BUILD_MODULE
+export module Localization;
+
+export namespace localization
+{
+	using localization::LookupHandle;
+	using localization::getLookupHandle;
+	using localization::getLocalizedString;
+
+	using localization::BaseTextLocalization;
+	using localization::TextLocalization;
+#ifndef __LINUX__
+	using localization::WTextLocalization;
+#endif
+	using localization::MultiLocalizationManager;
+	using localization::Holder;
+
+	using localization::LocalizedValue;
+	using localization::LocaleData;
+	using localization::OverlayTable;
+	using localization::DictionaryImage;
+#ifdef __LINUX__
+	using localization::SharedDictionary;
+#endif
+	using localization::LookupResult;
+	using localization::LookupTracer;
+	using localization::LookupTrace;
+	using localization::TraceRecord;
+	using localization::ReverseIndex;
+	using localization::KeyNormalization;
+	using localization::NormalizedKeyIndex;
+	using localization::MessageCache;
+
+	using localization::operator |;
+	using localization::operator &;
+}
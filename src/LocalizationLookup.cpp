@@ -0,0 +1,58 @@
+#include "LocalizationLookup.h"
+
+#include "MultiLocalizationManager.h"
+
+namespace localization
+{
+	LookupHandle::LookupHandle(const TextLocalization* localization) :
+		dictionaries(localization->dictionaries),
+		localization(localization)
+	{
+
+	}
+
+	LookupHandle::LookupHandle() :
+		dictionaries(nullptr),
+		localization(nullptr)
+	{
+
+	}
+
+	std::string_view LookupHandle::getString(std::string_view key, std::string_view language, bool allowOriginal) const
+	{
+		return localization->getString(key, language.empty() ? localization->getCurrentLanguage() : language, allowOriginal);
+	}
+
+	std::string_view LookupHandle::getCurrentLanguage() const
+	{
+		return localization->getCurrentLanguage();
+	}
+
+	std::string_view LookupHandle::getOriginalLanguage() const
+	{
+		return localization->getOriginalLanguage();
+	}
+
+	LookupHandle::operator bool() const
+	{
+		return localization;
+	}
+
+	LookupHandle getLookupHandle(std::string_view localizationModuleName)
+	{
+		MultiLocalizationManager& manager = MultiLocalizationManager::getManager();
+
+		if (localizationModuleName.empty() || localizationModuleName == manager.getDefaultModuleName())
+		{
+			// Manager created by getSharedManager doesn't load default module
+			return LookupHandle(&TextLocalization::get());
+		}
+
+		return LookupHandle(&manager.getModule(localizationModuleName)->localization);
+	}
+
+	std::string_view getLocalizedString(std::string_view localizationModuleName, std::string_view key, std::string_view language)
+	{
+		return MultiLocalizationManager::getManager().getLocalizedString(localizationModuleName, key, language);
+	}
+}
@@ -0,0 +1,447 @@
+#include "LookupTracer.h"
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <fstream>
+#include <memory>
+#include <unordered_map>
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <format>
+
+#include "StringViewUtils.h"
+
+namespace
+{
+	/// @brief LOCTRACE
+	constexpr uint64_t traceMagic = 0x4543415254434F4CULL;
+	constexpr uint32_t traceVersion = 2;
+
+	enum class Chunk : uint8_t
+	{
+		string,
+		record
+	};
+
+	struct Record
+	{
+		uint64_t timestamp;
+		uint8_t result;
+		/// @brief Sizes of traced strings before truncation
+		uint32_t moduleSize;
+		uint32_t languageSize;
+		uint32_t keySize;
+		char module[localization::LookupTracer::maxModuleSize];
+		char language[localization::LookupTracer::maxLanguageSize];
+		char key[localization::LookupTracer::maxKeySize];
+	};
+
+	/// @brief Single producer(owner thread) single consumer(flusher) ring
+	struct ThreadBuffer
+	{
+		std::unique_ptr<Record[]> records;
+		uint64_t mask;
+		uint32_t thread;
+		uint64_t session;
+		alignas(64) std::atomic<uint64_t> head;
+		alignas(64) std::atomic<uint64_t> tail;
+		std::atomic<uint64_t> dropped;
+
+		ThreadBuffer(size_t capacity, uint32_t thread, uint64_t session) :
+			records(std::make_unique<Record[]>(capacity)),
+			mask(capacity - 1),
+			thread(thread),
+			session(session),
+			head(0),
+			tail(0),
+			dropped(0)
+		{
+
+		}
+	};
+
+	struct TracerState
+	{
+		std::atomic<bool> enabled = false;
+		/// @brief Serializes start and stop
+		std::mutex controlMutex;
+		/// @brief Guards buffers and running. Never held during file output
+		std::mutex mutex;
+		std::condition_variable wake;
+		std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+		std::ofstream output;
+		std::thread flusher;
+		std::chrono::steady_clock::time_point start;
+		size_t capacity = 0;
+		std::atomic<uint64_t> session = 0;
+		bool running = false;
+		// Flusher thread, then stop after flusher is joined
+		std::unordered_map<std::string, uint32_t, localization::utility::StringViewHash, localization::utility::StringViewEqual> strings;
+		uint64_t lastTimestamp = 0;
+		uint64_t dropped = 0;
+	};
+
+	TracerState& getState()
+	{
+		static TracerState state;
+
+		return state;
+	}
+
+	void writeVarint(std::ofstream& output, uint64_t value)
+	{
+		char buffer[10];
+		size_t size = 0;
+
+		do
+		{
+			buffer[size++] = static_cast<char>((value & 0x7F) | (value > 0x7F ? 0x80 : 0));
+
+			value >>= 7;
+		} while (value);
+
+		output.write(buffer, size);
+	}
+
+	uint64_t readVarint(std::ifstream& input)
+	{
+		uint64_t result = 0;
+
+		for (int shift = 0; shift < 64; shift += 7)
+		{
+			int value = input.get();
+
+			if (value == std::char_traits<char>::eof())
+			{
+				throw std::runtime_error("Unexpected end of trace");
+			}
+
+			result |= static_cast<uint64_t>(value & 0x7F) << shift;
+
+			if (!(value & 0x80))
+			{
+				break;
+			}
+		}
+
+		return result;
+	}
+
+	uint32_t internString(TracerState& state, std::string_view value)
+	{
+		if (auto it = state.strings.find(value); it != state.strings.end())
+		{
+			return it->second;
+		}
+
+		uint32_t id = static_cast<uint32_t>(state.strings.size());
+
+		state.strings.try_emplace(std::string(value), id);
+
+		state.output.put(static_cast<char>(Chunk::string));
+		writeVarint(state.output, id);
+		writeVarint(state.output, value.size());
+		state.output.write(value.data(), value.size());
+
+		return id;
+	}
+
+	/// @brief Drain buffers and write their records. Only one thread flushes at a time, state.mutex must not be locked
+	/// @param buffers Copy of state.buffers taken under state.mutex
+	void flush(TracerState& state, const std::vector<std::shared_ptr<ThreadBuffer>>& buffers)
+	{
+		std::vector<std::pair<uint32_t, Record>> records;
+
+		for (const std::shared_ptr<ThreadBuffer>& buffer : buffers)
+		{
+			uint64_t tail = buffer->tail.load(std::memory_order_relaxed);
+			uint64_t head = buffer->head.load(std::memory_order_acquire);
+
+			for (; tail != head; tail++)
+			{
+				records.emplace_back(buffer->thread, buffer->records[tail & buffer->mask]);
+			}
+
+			buffer->tail.store(tail, std::memory_order_release);
+		}
+
+		std::sort(records.begin(), records.end(), [](const auto& left, const auto& right) { return left.second.timestamp < right.second.timestamp; });
+
+		for (const auto& [thread, record] : records)
+		{
+			uint32_t module = internString(state, std::string_view(record.module, std::min<size_t>(record.moduleSize, localization::LookupTracer::maxModuleSize)));
+			uint32_t language = internString(state, std::string_view(record.language, std::min<size_t>(record.languageSize, localization::LookupTracer::maxLanguageSize)));
+			uint32_t key = internString(state, std::string_view(record.key, std::min<size_t>(record.keySize, localization::LookupTracer::maxKeySize)));
+			bool truncated = record.moduleSize > localization::LookupTracer::maxModuleSize || record.languageSize > localization::LookupTracer::maxLanguageSize || record.keySize > localization::LookupTracer::maxKeySize;
+			int64_t delta = static_cast<int64_t>(record.timestamp - state.lastTimestamp);
+
+			state.output.put(static_cast<char>(Chunk::record));
+			// Zigzag, records of different flushes can be slightly out of order
+			writeVarint(state.output, (static_cast<uint64_t>(delta) << 1) ^ static_cast<uint64_t>(delta >> 63));
+			writeVarint(state.output, thread);
+			state.output.put(static_cast<char>(record.result));
+			state.output.put(static_cast<char>(truncated));
+			writeVarint(state.output, module);
+			writeVarint(state.output, language);
+			writeVarint(state.output, key);
+
+			state.lastTimestamp = record.timestamp;
+		}
+
+		state.output.flush();
+	}
+
+	ThreadBuffer* getThreadBuffer(TracerState& state)
+	{
+		thread_local std::shared_ptr<ThreadBuffer> buffer;
+
+		if (!buffer || buffer->session != state.session.load(std::memory_order_relaxed))
+		{
+			std::unique_lock<std::mutex> lock(state.mutex);
+
+			if (!state.running)
+			{
+				return nullptr;
+			}
+
+			buffer = std::make_shared<ThreadBuffer>(state.capacity, static_cast<uint32_t>(state.buffers.size()), state.session.load(std::memory_order_relaxed));
+
+			state.buffers.push_back(buffer);
+		}
+
+		return buffer.get();
+	}
+
+	/// @return Size of source
+	uint32_t copyTruncated(char* destination, size_t maxSize, std::string_view source)
+	{
+		std::memcpy(destination, source.data(), std::min(maxSize, source.size()));
+
+		return static_cast<uint32_t>(std::min<size_t>(source.size(), UINT32_MAX));
+	}
+}
+
+namespace localization
+{
+	LookupTrace LookupTrace::load(const std::filesystem::path& pathToTrace)
+	{
+		std::ifstream input(pathToTrace, std::ios::binary);
+		LookupTrace result;
+		uint64_t magic = 0;
+		uint32_t version = 0;
+		uint64_t timestamp = 0;
+
+		if (!input.is_open())
+		{
+			throw std::runtime_error(std::format("Can't open {}", pathToTrace.string()));
+		}
+
+		input.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+		input.read(reinterpret_cast<char*>(&version), sizeof(version));
+
+		if (magic != traceMagic || version != traceVersion)
+		{
+			throw std::runtime_error(std::format("{} is not a trace file", pathToTrace.string()));
+		}
+
+		for (int chunk = input.get(); chunk != std::char_traits<char>::eof(); chunk = input.get())
+		{
+			if (static_cast<Chunk>(chunk) == Chunk::string)
+			{
+				uint64_t id = readVarint(input);
+				std::string value(readVarint(input), '\0');
+
+				input.read(value.data(), value.size());
+
+				if (id != result.strings.size())
+				{
+					throw std::runtime_error(std::format("Wrong string id in {}", pathToTrace.string()));
+				}
+
+				result.strings.push_back(std::move(value));
+			}
+			else if (static_cast<Chunk>(chunk) == Chunk::record)
+			{
+				TraceRecord& record = result.records.emplace_back();
+				uint64_t delta = readVarint(input);
+
+				timestamp += static_cast<uint64_t>(static_cast<int64_t>(delta >> 1) ^ -static_cast<int64_t>(delta & 1));
+
+				record.timestamp = timestamp;
+				record.thread = static_cast<uint32_t>(readVarint(input));
+				record.result = static_cast<LookupResult>(input.get());
+				record.truncated = input.get() == 1;
+				record.module = static_cast<uint32_t>(readVarint(input));
+				record.language = static_cast<uint32_t>(readVarint(input));
+				record.key = static_cast<uint32_t>(readVarint(input));
+
+				if (std::max({ record.module, record.language, record.key }) >= result.strings.size())
+				{
+					throw std::runtime_error(std::format("Wrong string id in {}", pathToTrace.string()));
+				}
+			}
+			else
+			{
+				throw std::runtime_error(std::format("Wrong chunk type in {}", pathToTrace.string()));
+			}
+		}
+
+		std::stable_sort(result.records.begin(), result.records.end(), [](const TraceRecord& left, const TraceRecord& right) { return left.timestamp < right.timestamp; });
+
+		return result;
+	}
+
+	void LookupTracer::start(const std::filesystem::path& pathToTrace, size_t recordsPerThread, std::chrono::milliseconds flushPeriod)
+	{
+		TracerState& state = getState();
+		std::unique_lock<std::mutex> controlLock(state.controlMutex);
+		std::unique_lock<std::mutex> lock(state.mutex);
+
+		if (state.running)
+		{
+			throw std::runtime_error("Lookup tracing is already started");
+		}
+
+		state.output.open(pathToTrace, std::ios::binary | std::ios::trunc);
+
+		if (!state.output.is_open())
+		{
+			throw std::runtime_error(std::format("Can't open {}", pathToTrace.string()));
+		}
+
+		state.output.write(reinterpret_cast<const char*>(&traceMagic), sizeof(traceMagic));
+		state.output.write(reinterpret_cast<const char*>(&traceVersion), sizeof(traceVersion));
+
+		state.buffers.clear();
+		state.strings.clear();
+		state.capacity = std::bit_ceil(std::max<size_t>(recordsPerThread, 2));
+		state.session.fetch_add(1, std::memory_order_relaxed);
+		state.lastTimestamp = 0;
+		state.dropped = 0;
+		state.start = std::chrono::steady_clock::now();
+		state.running = true;
+
+		state.flusher = std::thread
+		(
+			[&state, flushPeriod]()
+			{
+				std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+
+				while (true)
+				{
+					{
+						std::unique_lock<std::mutex> lock(state.mutex);
+
+						if (!state.running)
+						{
+							break;
+						}
+
+						state.wake.wait_for(lock, flushPeriod);
+
+						buffers = state.buffers;
+					}
+
+					// New threads register their buffers while file is written
+					flush(state, buffers);
+				}
+			}
+		);
+
+		state.enabled.store(true, std::memory_order_release);
+	}
+
+	uint64_t LookupTracer::stop()
+	{
+		TracerState& state = getState();
+		std::unique_lock<std::mutex> controlLock(state.controlMutex);
+		std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+
+		state.enabled.store(false, std::memory_order_release);
+
+		{
+			std::unique_lock<std::mutex> lock(state.mutex);
+
+			if (!state.running)
+			{
+				return 0;
+			}
+
+			state.running = false;
+		}
+
+		state.wake.notify_all();
+		state.flusher.join();
+
+		{
+			std::unique_lock<std::mutex> lock(state.mutex);
+
+			buffers = std::move(state.buffers);
+
+			state.buffers.clear();
+		}
+
+		flush(state, buffers);
+
+		for (const std::shared_ptr<ThreadBuffer>& buffer : buffers)
+		{
+			state.dropped += buffer->dropped.load(std::memory_order_relaxed);
+		}
+
+		state.output.close();
+
+		return state.dropped;
+	}
+
+	bool LookupTracer::isEnabled()
+	{
+		return getState().enabled.load(std::memory_order_relaxed);
+	}
+
+	void LookupTracer::record(std::string_view module, std::string_view language, std::string_view key, LookupResult result) noexcept
+	{
+		TracerState& state = getState();
+		ThreadBuffer* buffer = nullptr;
+
+		if (!state.enabled.load(std::memory_order_acquire))
+		{
+			return;
+		}
+
+		try
+		{
+			buffer = getThreadBuffer(state);
+		}
+		catch (...)
+		{
+			return;
+		}
+
+		if (!buffer)
+		{
+			return;
+		}
+
+		uint64_t head = buffer->head.load(std::memory_order_relaxed);
+
+		if (head - buffer->tail.load(std::memory_order_acquire) > buffer->mask)
+		{
+			buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+
+			return;
+		}
+
+		Record& record = buffer->records[head & buffer->mask];
+
+		record.timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - state.start).count();
+		record.result = static_cast<uint8_t>(result);
+		record.moduleSize = copyTruncated(record.module, maxModuleSize, module);
+		record.languageSize = copyTruncated(record.language, maxLanguageSize, language);
+		record.keySize = copyTruncated(record.key, maxKeySize, key);
+
+		buffer->head.store(head + 1, std::memory_order_release);
+	}
+}
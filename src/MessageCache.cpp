@@ -0,0 +1,416 @@
+#include "MessageCache.h"
+
+#include <thread>
+#include <mutex>
+#include <shared_mutex>
+#include <atomic>
+#include <unordered_map>
+#include <array>
+#include <tuple>
+#include <format>
+#include <algorithm>
+#include <bit>
+
+#include "StringViewUtils.h"
+
+/// @brief Forwards format specification to std::formatter of stored type
+template<>
+struct std::formatter<localization::MessageArgument>
+{
+private:
+	std::string_view specification;
+
+private:
+	template<typename T>
+	std::format_context::iterator formatValue(const T& value, std::format_context& context) const
+	{
+		std::formatter<T> formatter;
+		std::format_parse_context parseContext(specification);
+
+		parseContext.advance_to(formatter.parse(parseContext));
+
+		return formatter.format(value, context);
+	}
+
+public:
+	constexpr std::format_parse_context::iterator parse(std::format_parse_context& context)
+	{
+		auto end = std::find(context.begin(), context.end(), '}');
+
+		specification = std::string_view(context.begin(), end);
+
+		return end;
+	}
+
+	std::format_context::iterator format(const localization::MessageArgument& argument, std::format_context& context) const
+	{
+		using Type = localization::MessageArgument::Type;
+
+		switch (argument.type)
+		{
+		case Type::boolean:
+			return this->formatValue(argument.boolean, context);
+
+		case Type::character:
+			return this->formatValue(argument.character, context);
+
+		case Type::signedInteger:
+			return this->formatValue(argument.signedInteger, context);
+
+		case Type::unsignedInteger:
+			return this->formatValue(argument.unsignedInteger, context);
+
+		case Type::singlePrecision:
+			return this->formatValue(argument.singlePrecision, context);
+
+		case Type::doublePrecision:
+			return this->formatValue(argument.doublePrecision, context);
+
+		case Type::string:
+			return this->formatValue(argument.string, context);
+
+		default:
+			throw std::format_error("Argument index out of range");
+		}
+	}
+};
+
+namespace localization
+{
+	struct MessageCache::Slot
+	{
+		uint64_t hash = 0;
+		uint64_t arguments = 0;
+		/// @brief module\0language\0key
+		std::string identity;
+		size_t moduleSize = 0;
+		std::shared_ptr<const std::string> message;
+		std::atomic<bool> referenced = false;
+	};
+
+	struct MessageCache::Shard
+	{
+		mutable std::shared_mutex mutex;
+		std::unique_ptr<Slot[]> slots;
+		size_t capacity = 0;
+		size_t hand = 0;
+		std::unordered_map<uint64_t, size_t> indices;
+		size_t memoryUsage = 0;
+		std::atomic<uint64_t> hits = 0;
+		std::atomic<uint64_t> misses = 0;
+		uint64_t evictions = 0;
+	};
+
+	MessageArgument::MessageArgument() noexcept :
+		type(Type::none),
+		unsignedInteger(0)
+	{
+
+	}
+
+	std::string MessageArgument::render(std::string_view format, std::span<const MessageArgument> arguments)
+	{
+		if (arguments.size() > MessageArgument::maxCount)
+		{
+			throw std::format_error(std::format("Message can't have more than {} arguments", MessageArgument::maxCount));
+		}
+
+		// Unused arguments are empty and throw if format string references them
+		std::array<MessageArgument, MessageArgument::maxCount> values;
+
+		std::copy(arguments.begin(), arguments.end(), values.begin());
+
+		return std::apply
+		(
+			[format](const auto&... args)
+			{
+				return std::vformat(format, std::make_format_args(args...));
+			},
+			values
+		);
+	}
+
+	double MessageCache::Statistics::getHitRate() const
+	{
+		return hits + misses ? static_cast<double>(hits) / (hits + misses) : 0.0;
+	}
+
+	uint64_t MessageCache::hash(std::string_view module, std::string_view language, std::string_view key, uint64_t arguments)
+	{
+		uint64_t result = utility::stableHash(module);
+
+		result = (result ^ utility::stableHash(language)) * 1099511628211ULL;
+		result = (result ^ utility::stableHash(key)) * 1099511628211ULL;
+
+		return (result ^ arguments) * 1099511628211ULL;
+	}
+
+	uint64_t MessageCache::hashArguments(std::span<const MessageArgument> arguments)
+	{
+		uint64_t result = arguments.size();
+
+		for (const MessageArgument& argument : arguments)
+		{
+			uint64_t value = 0;
+
+			switch (argument.type)
+			{
+			case MessageArgument::Type::boolean:
+				value = argument.boolean;
+
+				break;
+
+			case MessageArgument::Type::character:
+				value = static_cast<unsigned char>(argument.character);
+
+				break;
+
+			case MessageArgument::Type::signedInteger:
+				value = static_cast<uint64_t>(argument.signedInteger);
+
+				break;
+
+			case MessageArgument::Type::unsignedInteger:
+				value = argument.unsignedInteger;
+
+				break;
+
+			case MessageArgument::Type::singlePrecision:
+				value = std::bit_cast<uint32_t>(argument.singlePrecision);
+
+				break;
+
+			case MessageArgument::Type::doublePrecision:
+				value = std::bit_cast<uint64_t>(argument.doublePrecision);
+
+				break;
+
+			case MessageArgument::Type::string:
+				value = utility::stableHash(argument.string);
+
+				break;
+
+			default:
+				break;
+			}
+
+			// Type is mixed in separately, so equal bits of different types don't collide. splitmix64 finalizer
+			for (uint64_t part : { static_cast<uint64_t>(argument.type), value })
+			{
+				result = (result ^ part) + 0x9E3779B97F4A7C15ULL;
+				result = (result ^ (result >> 30)) * 0xBF58476D1CE4E5B9ULL;
+				result = (result ^ (result >> 27)) * 0x94D049BB133111EBULL;
+				result ^= result >> 31;
+			}
+		}
+
+		return result;
+	}
+
+	bool MessageCache::isSame(const Slot& slot, std::string_view module, std::string_view language, std::string_view key, uint64_t arguments)
+	{
+		return slot.arguments == arguments &&
+			slot.identity.size() == module.size() + language.size() + key.size() + 2 &&
+			std::string_view(slot.identity).substr(0, module.size()) == module &&
+			std::string_view(slot.identity).substr(module.size() + 1, language.size()) == language &&
+			std::string_view(slot.identity).substr(module.size() + language.size() + 2) == key;
+	}
+
+	size_t MessageCache::getMemoryUsage(const Slot& slot)
+	{
+		// Message string with shared_ptr control block and indices node
+		return slot.identity.capacity() + sizeof(std::string) + slot.message->capacity() + 2 * sizeof(void*) + sizeof(std::pair<uint64_t, size_t>) + sizeof(void*);
+	}
+
+	void MessageCache::release(Shard& shard, Slot& slot)
+	{
+		shard.indices.erase(slot.hash);
+		shard.memoryUsage -= MessageCache::getMemoryUsage(slot);
+
+		slot.message.reset();
+		slot.identity.clear();
+		slot.referenced.store(false, std::memory_order_relaxed);
+	}
+
+	MessageCache::Shard& MessageCache::getShard(uint64_t hash) const
+	{
+		return shards[(hash >> 32) % shardsCount];
+	}
+
+	std::atomic<uint64_t>& MessageCache::getModuleEpoch(std::string_view module) const
+	{
+		return epochs[utility::stableHash(module) % epochsCount];
+	}
+
+	MessageCache::MessageCache(size_t capacity, size_t shardsCount) :
+		shards(std::make_unique<Shard[]>(shardsCount ? shardsCount : std::max(std::thread::hardware_concurrency(), 1U))),
+		shardsCount(shardsCount ? shardsCount : std::max(std::thread::hardware_concurrency(), 1U)),
+		epochs(std::make_unique<std::atomic<uint64_t>[]>(epochsCount))
+	{
+		for (size_t i = 0; i < this->shardsCount; i++)
+		{
+			shards[i].capacity = std::max<size_t>((capacity + this->shardsCount - 1) / this->shardsCount, 1);
+			shards[i].slots = std::make_unique<Slot[]>(shards[i].capacity);
+
+			shards[i].indices.reserve(shards[i].capacity);
+		}
+	}
+
+	std::shared_ptr<const std::string> MessageCache::find(std::string_view module, std::string_view language, std::string_view key, uint64_t arguments) const
+	{
+		uint64_t hash = MessageCache::hash(module, language, key, arguments);
+		Shard& shard = this->getShard(hash);
+		std::shared_lock<std::shared_mutex> lock(shard.mutex);
+
+		if (auto it = shard.indices.find(hash); it != shard.indices.end())
+		{
+			Slot& slot = shard.slots[it->second];
+
+			if (MessageCache::isSame(slot, module, language, key, arguments))
+			{
+				slot.referenced.store(true, std::memory_order_relaxed);
+				shard.hits.fetch_add(1, std::memory_order_relaxed);
+
+				return slot.message;
+			}
+		}
+
+		shard.misses.fetch_add(1, std::memory_order_relaxed);
+
+		return nullptr;
+	}
+
+	uint64_t MessageCache::getEpoch(std::string_view module) const
+	{
+		return this->getModuleEpoch(module).load(std::memory_order_acquire);
+	}
+
+	std::shared_ptr<const std::string> MessageCache::insert(std::string_view module, std::string_view language, std::string_view key, uint64_t arguments, std::string&& message, uint64_t epoch)
+	{
+		uint64_t hash = MessageCache::hash(module, language, key, arguments);
+		Shard& shard = this->getShard(hash);
+		std::shared_ptr<const std::string> result = std::make_shared<const std::string>(std::move(message));
+		std::unique_lock<std::shared_mutex> lock(shard.mutex);
+		size_t index = 0;
+
+		// invalidate advances epoch before it locks shards, so stale message is either dropped here or removed by invalidate
+		if (this->getModuleEpoch(module).load(std::memory_order_acquire) != epoch)
+		{
+			return result;
+		}
+
+		if (auto it = shard.indices.find(hash); it != shard.indices.end())
+		{
+			// Same message rendered by other thread or hash collision
+			index = it->second;
+
+			MessageCache::release(shard, shard.slots[index]);
+		}
+		else
+		{
+			while (true)
+			{
+				Slot& slot = shard.slots[shard.hand];
+
+				index = shard.hand;
+				shard.hand = (shard.hand + 1) % shard.capacity;
+
+				if (!slot.message)
+				{
+					break;
+				}
+
+				if (!slot.referenced.exchange(false, std::memory_order_relaxed))
+				{
+					MessageCache::release(shard, slot);
+
+					shard.evictions++;
+
+					break;
+				}
+			}
+		}
+
+		Slot& slot = shard.slots[index];
+
+		slot.hash = hash;
+		slot.arguments = arguments;
+		slot.moduleSize = module.size();
+		slot.message = result;
+
+		slot.identity.reserve(module.size() + language.size() + key.size() + 2);
+		slot.identity.append(module).push_back('\0');
+		slot.identity.append(language).push_back('\0');
+		slot.identity.append(key);
+
+		shard.indices.try_emplace(hash, index);
+		shard.memoryUsage += MessageCache::getMemoryUsage(slot);
+
+		return result;
+	}
+
+	void MessageCache::invalidate(std::string_view module)
+	{
+		this->getModuleEpoch(module).fetch_add(1, std::memory_order_acq_rel);
+
+		for (size_t i = 0; i < shardsCount; i++)
+		{
+			Shard& shard = shards[i];
+			std::unique_lock<std::shared_mutex> lock(shard.mutex);
+
+			for (size_t j = 0; j < shard.capacity; j++)
+			{
+				Slot& slot = shard.slots[j];
+
+				if (slot.message && std::string_view(slot.identity).substr(0, slot.moduleSize) == module)
+				{
+					MessageCache::release(shard, slot);
+				}
+			}
+		}
+	}
+
+	void MessageCache::clear()
+	{
+		for (size_t i = 0; i < epochsCount; i++)
+		{
+			epochs[i].fetch_add(1, std::memory_order_acq_rel);
+		}
+
+		for (size_t i = 0; i < shardsCount; i++)
+		{
+			Shard& shard = shards[i];
+			std::unique_lock<std::shared_mutex> lock(shard.mutex);
+
+			for (size_t j = 0; j < shard.capacity; j++)
+			{
+				if (shard.slots[j].message)
+				{
+					MessageCache::release(shard, shard.slots[j]);
+				}
+			}
+		}
+	}
+
+	MessageCache::Statistics MessageCache::getStatistics() const
+	{
+		Statistics result = {};
+
+		for (size_t i = 0; i < shardsCount; i++)
+		{
+			Shard& shard = shards[i];
+			std::shared_lock<std::shared_mutex> lock(shard.mutex);
+
+			result.hits += shard.hits.load(std::memory_order_relaxed);
+			result.misses += shard.misses.load(std::memory_order_relaxed);
+			result.evictions += shard.evictions;
+			result.entries += shard.indices.size();
+			result.capacity += shard.capacity;
+			result.memoryUsage += shard.memoryUsage;
+		}
+
+		return result;
+	}
+
+	MessageCache::~MessageCache() = default;
+}
@@ -0,0 +1,300 @@
+#include "ModuleArena.h"
+
+#include <new>
+#include <algorithm>
+
+#ifdef __LINUX__
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#include <Windows.h>
+#endif
+
+namespace
+{
+	/// @brief Default huge page size of x86-64 and aarch64 with 4 KB pages
+	constexpr size_t hugePageSize = 2 * 1024 * 1024;
+#ifdef __LINUX__
+	/// @brief MPOL_PREFERRED from numaif.h, libnuma isn't required
+	constexpr int preferredNodePolicy = 1;
+#endif
+
+	size_t roundUp(size_t value, size_t alignment)
+	{
+		return (value + alignment - 1) / alignment * alignment;
+	}
+
+	size_t getPageSize()
+	{
+#ifdef __LINUX__
+		static const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#else
+		static const size_t pageSize = []()
+			{
+				SYSTEM_INFO info = {};
+
+				GetSystemInfo(&info);
+
+				return static_cast<size_t>(info.dwPageSize);
+			}();
+#endif
+
+		return pageSize;
+	}
+
+	/// @return nullptr if huge pages pool is empty or privilege is missing
+	std::byte* allocateHugePages(size_t& size)
+	{
+#ifdef __LINUX__
+		size = roundUp(size, hugePageSize);
+
+		void* result = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+
+		return result == MAP_FAILED ? nullptr : static_cast<std::byte*>(result);
+#else
+		size_t largePageSize = GetLargePageMinimum();
+
+		if (!largePageSize)
+		{
+			return nullptr;
+		}
+
+		size = roundUp(size, largePageSize);
+
+		return static_cast<std::byte*>(VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE));
+#endif
+	}
+
+	/// @exception std::bad_alloc
+	std::byte* allocatePages(size_t& size, bool transparentHugePages)
+	{
+#ifdef __LINUX__
+		if (!transparentHugePages)
+		{
+			size = roundUp(size, getPageSize());
+
+			void* result = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+			if (result == MAP_FAILED)
+			{
+				throw std::bad_alloc();
+			}
+
+			return static_cast<std::byte*>(result);
+		}
+
+		size = roundUp(size, hugePageSize);
+
+		// Reserve one more huge page and trim, so whole chunk is huge page aligned and can be collapsed
+		size_t reservedSize = size + hugePageSize;
+		void* reserved = mmap(nullptr, reservedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+		if (reserved == MAP_FAILED)
+		{
+			throw std::bad_alloc();
+		}
+
+		std::byte* start = static_cast<std::byte*>(reserved);
+		std::byte* result = start + (roundUp(reinterpret_cast<uintptr_t>(start), hugePageSize) - reinterpret_cast<uintptr_t>(start));
+
+		if (result != start)
+		{
+			munmap(start, result - start);
+		}
+
+		if (std::byte* end = result + size; end != start + reservedSize)
+		{
+			munmap(end, start + reservedSize - end);
+		}
+
+		madvise(result, size, MADV_HUGEPAGE);
+
+		return result;
+#else
+		size = roundUp(size, getPageSize());
+
+		if (void* result = VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE))
+		{
+			return static_cast<std::byte*>(result);
+		}
+
+		throw std::bad_alloc();
+#endif
+	}
+
+	/// @brief Must be called before pages are touched
+	void bindPages(std::byte* data, size_t size, int32_t node)
+	{
+#ifdef __LINUX__
+		constexpr size_t bits = sizeof(unsigned long) * 8;
+		std::vector<unsigned long> mask(node / bits + 2);
+
+		mask[node / bits] |= 1UL << (node % bits);
+
+		// Kernel without NUMA support fails, pages are allocated on any node then
+		syscall(SYS_mbind, data, size, preferredNodePolicy, mask.data(), mask.size() * bits, 0);
+#endif
+	}
+
+	bool lockPages(std::byte* data, size_t size)
+	{
+#ifdef __LINUX__
+		return !mlock(data, size);
+#else
+		return VirtualLock(data, size);
+#endif
+	}
+
+	void freePages(std::byte* data, size_t size)
+	{
+#ifdef __LINUX__
+		munmap(data, size);
+#else
+		VirtualFree(data, 0, MEM_RELEASE);
+#endif
+	}
+}
+
+namespace localization
+{
+	std::byte* ModuleArena::addChunk(size_t minimumSize)
+	{
+		Chunk chunk = { nullptr, minimumSize, false, false };
+		// Huge page for smaller chunk would reserve more than it holds
+		ArenaPages pages = minimumSize < hugePageSize ? ArenaPages::normal : options.pages;
+
+		chunks.reserve(chunks.size() + 1);
+
+		if (pages == ArenaPages::explicitHuge)
+		{
+			chunk.data = allocateHugePages(chunk.size);
+			chunk.hugePages = chunk.data;
+		}
+
+		if (!chunk.data)
+		{
+			chunk.size = minimumSize;
+			chunk.data = allocatePages(chunk.size, pages != ArenaPages::normal);
+		}
+
+		if (options.node >= 0)
+		{
+			bindPages(chunk.data, chunk.size, options.node);
+		}
+
+		if (options.lock)
+		{
+			chunk.locked = lockPages(chunk.data, chunk.size);
+		}
+
+		chunks.push_back(chunk);
+
+		return chunk.data;
+	}
+
+	void* ModuleArena::do_allocate(size_t bytes, size_t alignment)
+	{
+		size_t padding = current ? (alignment - reinterpret_cast<uintptr_t>(current) % alignment) % alignment : 0;
+
+		if (!current || padding + bytes > remaining)
+		{
+			// Rest of current chunk stays available for next allocations
+			if (bytes + alignment > nextChunkSize)
+			{
+				std::byte* data = this->addChunk(bytes + alignment);
+
+				padding = (alignment - reinterpret_cast<uintptr_t>(data) % alignment) % alignment;
+				usedBytes += padding + bytes;
+
+				return data + padding;
+			}
+
+			current = this->addChunk(nextChunkSize);
+			remaining = chunks.back().size;
+			nextChunkSize = std::min(nextChunkSize * 2, std::max(options.chunkSize, getPageSize()));
+
+			padding = (alignment - reinterpret_cast<uintptr_t>(current) % alignment) % alignment;
+		}
+
+		std::byte* result = current + padding;
+
+		current = result + bytes;
+		remaining -= padding + bytes;
+		usedBytes += padding + bytes;
+
+		return result;
+	}
+
+	void ModuleArena::do_deallocate(void*, size_t, size_t)
+	{
+	}
+
+	bool ModuleArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+	{
+		return this == &other;
+	}
+
+	ModuleArena::ModuleArena() :
+		ModuleArena(Options())
+	{
+
+	}
+
+	ModuleArena::ModuleArena(const Options& options) :
+		options(options),
+		current(nullptr),
+		remaining(0),
+		usedBytes(0),
+		nextChunkSize(getPageSize())
+	{
+
+	}
+
+	void ModuleArena::release()
+	{
+		for (const Chunk& chunk : chunks)
+		{
+			freePages(chunk.data, chunk.size);
+		}
+
+		chunks.clear();
+
+		current = nullptr;
+		remaining = 0;
+		usedBytes = 0;
+		nextChunkSize = getPageSize();
+	}
+
+	const ModuleArena::Options& ModuleArena::getOptions() const
+	{
+		return options;
+	}
+
+	ModuleArena::Statistics ModuleArena::getStatistics() const
+	{
+		Statistics result = { chunks.size(), 0, usedBytes, 0, 0 };
+
+		for (const Chunk& chunk : chunks)
+		{
+			result.reservedBytes += chunk.size;
+
+			if (chunk.hugePages)
+			{
+				result.hugePagesBytes += chunk.size;
+			}
+
+			if (chunk.locked)
+			{
+				result.lockedBytes += chunk.size;
+			}
+		}
+
+		return result;
+	}
+
+	ModuleArena::~ModuleArena()
+	{
+		this->release();
+	}
+}
@@ -1,62 +1,421 @@
 #include "MultiLocalizationManager.h"
 
+#include <iostream>
 #include <fstream>
 #include <mutex>
+#include <shared_mutex>
+#include <future>
+#include <format>
+#include <cstdlib>
+#include <algorithm>
+#include <utility>
 
+#include <JsonParser.h>
 #include <JsonArrayWrapper.h>
 
 #include "LocalizationConstants.h"
+#include "LookupTracer.h"
+#include "ModuleArena.h"
+#include "UsageProfile.h"
+#include "ReverseIndex.h"
+#include "NumaReplicas.h"
+#include "UsageRecorder.h"
+#ifdef __LINUX__
+#include "SharedDictionary.h"
+#endif
+
+static std::vector<std::string> getStringsSetting(const json::JsonParser& settings, const std::string& key);
 
 namespace localization
 {
+	class MultiLocalizationManager::MapMutex : public std::shared_mutex
+	{
+
+	};
+
+	struct MultiLocalizationManager::ReverseIndexBuild
+	{
+		std::shared_future<std::shared_ptr<const ReverseIndex>> result;
+	};
+
 #ifdef __LINUX__
-	MultiLocalizationManager::LocalizationHolder::LocalizationHolder(TextLocalization&& localization) noexcept :
-		localization(std::move(localization))
+	MultiLocalizationManager::LocalizationHolder::LocalizationHolder(ModuleArena* arena, TextLocalization&& localization) noexcept :
+		arena(arena),
+		localization(std::move(localization)),
+		replicas(nullptr)
 	{
 
 	}
 #else
-	MultiLocalizationManager::LocalizationHolder::LocalizationHolder(TextLocalization&& localization, WTextLocalization&& wlocalization) noexcept :
+	MultiLocalizationManager::LocalizationHolder::LocalizationHolder(ModuleArena* arena, TextLocalization&& localization, WTextLocalization&& wlocalization) noexcept :
+		arena(arena),
 		localization(std::move(localization)),
-		wlocalization(std::move(wlocalization))
+		wlocalization(std::move(wlocalization)),
+		replicas(nullptr)
 	{
 
 	}
 #endif
 
-	MultiLocalizationManager::MultiLocalizationManager()
+	MultiLocalizationManager::LocalizationHolder::LocalizationHolder(LocalizationHolder&& other) noexcept = default;
+
+	MultiLocalizationManager::LocalizationHolder& MultiLocalizationManager::LocalizationHolder::operator = (LocalizationHolder&& other) noexcept = default;
+
+	MultiLocalizationManager::LocalizationHolder::~LocalizationHolder() = default;
+
+	MultiLocalizationManager::MultiLocalizationManager(bool loadModules) :
+		mapMutex(std::make_unique<MapMutex>()),
+		defaultKeyNormalization(false),
+		defaultReplicas(nullptr),
+		defaultReplication(false),
+		usageProfile(std::make_unique<UsageProfile>()),
+		usageRecording(false),
+		messageCache(nullptr)
 	{
+		if (const char* pathToTrace = std::getenv(traceEnvironmentVariable.data()); pathToTrace && *pathToTrace && !LookupTracer::isEnabled())
+		{
+			LookupTracer::start(pathToTrace);
+		}
+
+		if (!loadModules)
+		{
+			// Default module is loaded by first lookup
+			if (std::filesystem::exists(localizationModulesFile))
+			{
+				defaultModuleName = json::JsonParser(std::ifstream(localizationModulesFile.data())).get<std::string>(settings::defaultModuleSetting);
+			}
+
+			return;
+		}
+
 		if (!std::filesystem::exists(localizationModulesFile))
 		{
 			throw std::runtime_error(std::format("Can't find {}", localizationModulesFile));
 		}
 
-		TextLocalization::get();
+		TextLocalization::initialize();
 
 #ifndef __LINUX__
-		WTextLocalization::get();
+		WTextLocalization::initialize();
 #endif
 
-		settings.setJSONData(std::ifstream(localizationModulesFile.data()));
+		json::JsonParser settings(std::ifstream(localizationModulesFile.data()));
 
 		defaultModuleName = settings.get<std::string>(settings::defaultModuleSetting);
 
+		if (const char* pathToUsage = std::getenv(usageEnvironmentVariable.data()); pathToUsage && *pathToUsage)
+		{
+			this->pathToUsage = pathToUsage;
+
+			this->startUsageRecording();
+		}
+
 		if (settings.begin() != settings.end())
 		{
+			try
+			{
+				this->setUsageProfile(UsageProfile::load(settings.get<std::string>(settings::usageProfileSetting)));
+			}
+			catch (const json::exceptions::CantFindValueException&)
+			{
+
+			}
+
+			for (const std::string& value : getStringsSetting(settings, settings::arenaSetting))
+			{
+				if (value == "transparentHugePages")
+				{
+					arenaOptions.pages = ArenaPages::transparentHuge;
+				}
+				else if (value == "hugePages")
+				{
+					arenaOptions.pages = ArenaPages::explicitHuge;
+				}
+				else if (value == "lock")
+				{
+					arenaOptions.lock = true;
+				}
+				else
+				{
+					throw std::runtime_error(std::format(R"(Wrong arena value "{}", expected "transparentHugePages", "hugePages" or "lock")", value));
+				}
+			}
+
 			std::vector<std::string> modules = json::utility::JsonArrayWrapper(settings.get<std::vector<json::JsonObject>>(settings::modulesSetting)).as<std::string>();
 
 			for (const std::string& module : modules)
 			{
 				this->addModule(module);
 			}
+
+			for (const std::string& overlay : getStringsSetting(settings, settings::overlaysSetting))
+			{
+				size_t separator = overlay.find(':');
+
+				if (separator == std::string::npos)
+				{
+					throw std::runtime_error(std::format(R"(Wrong overlay value "{}", expected "overlayModule:baseModule")", overlay));
+				}
+
+				this->addOverlay(overlay.substr(0, separator), overlay.substr(separator + 1));
+			}
+
+			for (const std::string& value : getStringsSetting(settings, settings::keyNormalizationSetting))
+			{
+				size_t separator = value.find(':');
+				KeyNormalization normalization = KeyNormalization::all;
+
+				if (separator != std::string::npos)
+				{
+					std::string_view policy = std::string_view(value).substr(separator + 1);
+
+					if (policy == "case")
+					{
+						normalization = KeyNormalization::foldCase;
+					}
+					else if (policy == "separators")
+					{
+						normalization = KeyNormalization::ignoreSeparators;
+					}
+					else
+					{
+						throw std::runtime_error(std::format(R"(Wrong key normalization value "{}", expected "module", "module:case" or "module:separators")", value));
+					}
+				}
+
+				std::string module = value.substr(0, separator);
+
+				// Lookups use only one key of each group, so settings can't silently hide keys
+				for (const NormalizedKeyIndex::Ambiguity& ambiguity : this->setKeyNormalization(module, normalization))
+				{
+					std::cerr << std::format(R"(Key normalization of {} ignores key "{}" with the same normalized form as "{}")", module, ambiguity.ignoredKey, ambiguity.key) << std::endl;
+				}
+			}
+
+			for (const std::string& module : getStringsSetting(settings, settings::reverseIndexSetting))
+			{
+				this->buildReverseIndex(module);
+			}
+
+			for (const std::string& module : getStringsSetting(settings, settings::numaReplicasSetting))
+			{
+				this->enableNumaReplicas(module);
+			}
+		}
+	}
+
+	std::string_view MultiLocalizationManager::getCurrentLanguage(std::string_view localizationModuleName) const
+	{
+		if (localizationModuleName == defaultModuleName)
+		{
+			return TextLocalization::get().getCurrentLanguage();
+		}
+
+		if (auto it = localizations.find(localizationModuleName); it != localizations.end())
+		{
+			return it->second->localization.getCurrentLanguage();
+		}
+
+		return "";
+	}
+
+	void MultiLocalizationManager::invalidateMessages(std::string_view localizationModuleName)
+	{
+		if (MessageCache* cache = messageCache.load(std::memory_order_relaxed))
+		{
+			cache->invalidate(localizationModuleName);
+		}
+	}
+
+	std::shared_ptr<const std::string> MultiLocalizationManager::renderString(std::string_view localizationModuleName, std::string_view key, std::string_view language, std::span<const MessageArgument> arguments) const
+	{
+		MessageCache* cache = messageCache.load(std::memory_order_acquire);
+
+		if (!cache)
+		{
+			return std::make_shared<const std::string>(MessageArgument::render(this->getLocalizedString(localizationModuleName, key, language), arguments));
+		}
+
+		std::string currentLanguage;
+
+		if (language.empty())
+		{
+			if (localizationModuleName == defaultModuleName)
+			{
+				currentLanguage = TextLocalization::get().getCurrentLanguage();
+			}
+			else
+			{
+				std::shared_lock<std::shared_mutex> lock(*mapMutex);
+
+				currentLanguage = this->getCurrentLanguage(localizationModuleName);
+			}
+
+			language = currentLanguage;
+		}
+
+		// Read before localized value, so message rendered from value of removed or changed module isn't cached
+		uint64_t epoch = cache->getEpoch(localizationModuleName);
+		uint64_t argumentsHash = MessageCache::hashArguments(arguments);
+
+		if (std::shared_ptr<const std::string> result = cache->find(localizationModuleName, language, key, argumentsHash))
+		{
+			// Keys reached only through cached messages must stay in recorded profile
+			if (LookupTracer::isEnabled() || usageRecording.load(std::memory_order_relaxed))
+			{
+				this->getInstrumentedLocalizedValue(localizationModuleName, key, language);
+			}
+
+			return result;
+		}
+
+		std::string message = MessageArgument::render(this->getLocalizedString(localizationModuleName, key, language), arguments);
+
+		return cache->insert(localizationModuleName, language, key, argumentsHash, std::move(message), epoch);
+	}
+
+	void MultiLocalizationManager::rebuildOverlays(std::string_view changedModuleName)
+	{
+		// Table is declared after its arena, so it's destroyed first
+		struct Overlay
+		{
+			LocalizationHolder* holder;
+			std::string_view name;
+			std::unique_ptr<ModuleArena> arena;
+			std::unique_ptr<OverlayTable> table;
+		};
+
+		// Tables are replaced only after all of them are built
+		std::vector<Overlay> overlays;
+
+		for (auto& [name, holder] : localizations)
+		{
+			std::string_view current = name;
+			bool affected = changedModuleName.empty() || name == changedModuleName;
+
+			while (!affected)
+			{
+				auto baseIterator = overlayBases.find(current);
+
+				if (baseIterator == overlayBases.end())
+				{
+					break;
+				}
+
+				current = baseIterator->second;
+				affected = current == changedModuleName;
+			}
+
+			if (!affected)
+			{
+				continue;
+			}
+
+			std::vector<OverlayTable::Layer> layers;
+
+			layers.push_back
+			(
+				{
+					name,
+					&holder->localization
+#ifndef __LINUX__
+					, &holder->wlocalization
+#endif
+				}
+			);
+
+			current = name;
+
+			// Modules that aren't loaded are skipped, chain continues with their bases
+			for (auto baseIterator = overlayBases.find(current); baseIterator != overlayBases.end(); baseIterator = overlayBases.find(current))
+			{
+				const std::string& baseModuleName = baseIterator->second;
+
+				if (baseModuleName == defaultModuleName)
+				{
+					layers.push_back
+					(
+						{
+							defaultModuleName,
+							&TextLocalization::get()
+#ifndef __LINUX__
+							, &WTextLocalization::get()
+#endif
+						}
+					);
+
+					break;
+				}
+
+				current = baseModuleName;
+
+				auto it = localizations.find(baseModuleName);
+
+				if (it == localizations.end())
+				{
+					continue;
+				}
+
+				layers.push_back
+				(
+					{
+						it->first,
+						&it->second->localization
+#ifndef __LINUX__
+						, &it->second->wlocalization
+#endif
+					}
+				);
+			}
+
+			Overlay& overlay = overlays.emplace_back(holder, name);
+
+			if (layers.size() == 1)
+			{
+				continue;
+			}
+
+			std::reverse(layers.begin(), layers.end());
+
+			overlay.arena = std::make_unique<ModuleArena>(arenaOptions);
+			overlay.table = std::make_unique<OverlayTable>(std::move(layers), overlay.arena.get(), usageProfile.get());
+		}
+
+		for (Overlay& overlay : overlays)
+		{
+			// Previous table is destroyed before its arena is released
+			overlay.holder->overlay = std::move(overlay.table);
+			overlay.holder->overlayArena = std::move(overlay.arena);
+
+			this->invalidateMessages(overlay.name);
 		}
 	}
 
 	MultiLocalizationManager::~MultiLocalizationManager()
 	{
+		if (!pathToUsage.empty())
+		{
+			try
+			{
+				this->stopUsageRecording().save(pathToUsage);
+			}
+			catch (const std::exception&)
+			{
+
+			}
+		}
+
+		// Background builds use modules
+		for (const auto& [_, reverseIndex] : reverseIndexes)
+		{
+			reverseIndex->result.wait();
+		}
+
+		reverseIndexes.clear();
+
 		for (const auto& [_, localization] : localizations)
 		{
-			delete localization;
+			MultiLocalizationManager::destroyModule(localization);
 		}
 
 		localizations.clear();
@@ -69,55 +428,173 @@ namespace localization
 		return version;
 	}
 
-	MultiLocalizationManager& MultiLocalizationManager::getManager()
+	MultiLocalizationManager& MultiLocalizationManager::getInstance(bool loadModules)
 	{
-		static MultiLocalizationManager instance;
+		static MultiLocalizationManager instance(loadModules);
 
 		return instance;
 	}
 
+	MultiLocalizationManager& MultiLocalizationManager::getManager()
+	{
+		return MultiLocalizationManager::getInstance(true);
+	}
+
+#ifdef __LINUX__
+	MultiLocalizationManager& MultiLocalizationManager::getSharedManager()
+	{
+		return MultiLocalizationManager::getInstance(false);
+	}
+#endif
+
+	std::string_view MultiLocalizationManager::getDefaultModuleName() const
+	{
+		return defaultModuleName;
+	}
+
 	MultiLocalizationManager::LocalizationHolder* MultiLocalizationManager::addModule(const std::string& localizationModuleName, const std::filesystem::path& pathToLocalizationModule)
 	{
-		if (pathToLocalizationModule == defaultModuleName)
+		if (!defaultModuleName.empty() && pathToLocalizationModule == defaultModuleName)
 		{
 			throw std::runtime_error(format("pathToLocalizationModule can't be {}", defaultModuleName));
 		}
 
-		std::lock_guard<std::shared_mutex> lock(mapMutex);
+		std::lock_guard<std::shared_mutex> lock(*mapMutex);
+
+		if (auto it = localizations.find(localizationModuleName); it != localizations.end())
+		{
+			return it->second;
+		}
+
+#ifdef __LINUX__
+		if (sharedModules.contains(localizationModuleName))
+		{
+			throw std::runtime_error(std::format("Module {} is already attached from shared memory", localizationModuleName));
+		}
+#endif
 
-		TextLocalization textLocalizationModule(pathToLocalizationModule.string());
+		std::unique_ptr<ModuleArena> arena = std::make_unique<ModuleArena>(arenaOptions);
+		TextLocalization textLocalizationModule(pathToLocalizationModule.empty() ? localizationModuleName : pathToLocalizationModule.string());
 
 #ifndef __LINUX__
-		WTextLocalization wtextLocalizationModule(textLocalizationModule);
+		std::unique_ptr<ModuleArena> wideArena = std::make_unique<ModuleArena>(arenaOptions);
+		WTextLocalization wtextLocalizationModule(textLocalizationModule, wideArena.get(), usageProfile.get(), localizationModuleName);
 #endif
 
-		return localizations.try_emplace
+		LocalizationHolder* result = new (arena->allocate(sizeof(LocalizationHolder), alignof(LocalizationHolder))) LocalizationHolder
 		(
-			localizationModuleName,
-			new LocalizationHolder
-			(
-				std::move(textLocalizationModule)
+			arena.get(),
+			std::move(textLocalizationModule)
 #ifndef __LINUX__
-				, std::move(wtextLocalizationModule)
+			, std::move(wtextLocalizationModule)
 #endif
-			)
-		).first->second;
+		);
+
+		arena.release();
+
+#ifndef __LINUX__
+		result->wideArena = std::move(wideArena);
+#endif
+
+		try
+		{
+			localizations.try_emplace(localizationModuleName, result);
+
+			if (auto it = keyNormalizations.find(localizationModuleName); it != keyNormalizations.end())
+			{
+				this->buildNormalizedKeys(localizationModuleName, result->localization, it->second, result->normalizedKeys, &result->normalizedKeysArena);
+			}
+
+			this->updateReplicas(localizationModuleName, result->localization, result->replicas, result->builtReplicas);
+
+			if (usageRecording.load(std::memory_order_relaxed))
+			{
+				result->usageArena = std::make_unique<ModuleArena>(arenaOptions);
+				result->usage = std::make_unique<UsageRecorder>(result->localization, result->usageArena.get());
+			}
+
+			this->rebuildOverlays(localizationModuleName);
+
+			// Last, so failed add never destroys module read by background build
+			if (reverseIndexModules.contains(localizationModuleName))
+			{
+				this->startReverseIndex(localizationModuleName, result->localization);
+			}
+		}
+		catch (...)
+		{
+			// Overlays are rebuilt all or nothing, so no other module references holder
+			localizations.erase(localizationModuleName);
+
+			MultiLocalizationManager::destroyModule(result);
+
+			throw;
+		}
+
+		return result;
 	}
 
-	bool MultiLocalizationManager::removeModule(std::string_view localizationModuleName)
+	void MultiLocalizationManager::setArenaOptions(const ArenaOptions& options)
 	{
-		std::lock_guard<std::shared_mutex> lock(mapMutex);
+		std::lock_guard<std::shared_mutex> lock(*mapMutex);
 
-		auto it = localizations.find(localizationModuleName);
+		arenaOptions = options;
+	}
+
+	ArenaOptions MultiLocalizationManager::getArenaOptions() const
+	{
+		std::shared_lock<std::shared_mutex> lock(*mapMutex);
+
+		return arenaOptions;
+	}
+
+	bool MultiLocalizationManager::removeModule(std::string_view localizationModuleName)
+	{
+		LocalizationHolder* holder = nullptr;
+		std::unique_ptr<ReverseIndexBuild> reverseIndex;
 
-		if (it == localizations.end())
 		{
-			return false;
+			std::lock_guard<std::shared_mutex> lock(*mapMutex);
+
+			auto it = localizations.find(localizationModuleName);
+
+			if (it == localizations.end())
+			{
+				return false;
+			}
+
+			holder = it->second;
+
+			localizations.erase(it);
+
+			try
+			{
+				this->rebuildOverlays(localizationModuleName);
+			}
+			catch (...)
+			{
+				localizations.try_emplace(std::string(localizationModuleName), holder);
+
+				throw;
+			}
+
+			this->invalidateMessages(localizationModuleName);
+
+			if (auto reverseIndexIterator = reverseIndexes.find(localizationModuleName); reverseIndexIterator != reverseIndexes.end())
+			{
+				reverseIndex = std::move(reverseIndexIterator->second);
+
+				reverseIndexes.erase(reverseIndexIterator);
+			}
 		}
 
-		localizations.erase(it);
+		// Holder is unreachable, so background build is awaited and module is unloaded without blocking readers
+		if (reverseIndex)
+		{
+			reverseIndex->result.wait();
+		}
 
-		delete it->second;
+		MultiLocalizationManager::destroyModule(holder);
 
 		return true;
 	}
@@ -129,7 +606,7 @@ namespace localization
 			throw std::runtime_error(std::format("pathToLocalizationModule can't be {}", defaultModuleName));
 		}
 
-		std::shared_lock<std::shared_mutex> lock(mapMutex);
+		std::shared_lock<std::shared_mutex> lock(*mapMutex);
 
 		if (auto it = localizations.find(localizationModuleName); it != localizations.end())
 		{
@@ -141,45 +618,1049 @@ namespace localization
 		return nullptr;
 	}
 
-	std::string_view MultiLocalizationManager::getLocalizedString(std::string_view localizationModuleName, std::string_view key, std::string_view language) const
+	void MultiLocalizationManager::addOverlay(const std::string& overlayModuleName, const std::string& baseModuleName)
 	{
-		if (localizationModuleName == defaultModuleName)
+		if (overlayModuleName == defaultModuleName)
 		{
-			return TextLocalization::get().getString(key, language);
+			throw std::runtime_error(std::format("Overlay module can't be {}", defaultModuleName));
 		}
 
-		std::shared_lock<std::shared_mutex> lock(mapMutex);
-		auto it = localizations.find(localizationModuleName);
+		std::lock_guard<std::shared_mutex> lock(*mapMutex);
 
-		if (it == localizations.end())
+		for (std::string_view current = baseModuleName; ;)
 		{
-			throw std::runtime_error(std::format("Can't find Localization holder with module name: {}", localizationModuleName));
-		}
+			if (current == overlayModuleName)
+			{
+				throw std::runtime_error(std::format("Overlay {} over {} creates cycle", overlayModuleName, baseModuleName));
+			}
 
-		TextLocalization& text = it->second->localization;
+			auto it = overlayBases.find(current);
 
-		return language.empty() ? text[key] : text.getString(key, language);
-	}
+			if (it == overlayBases.end())
+			{
+				break;
+			}
 
-#ifndef __LINUX__
-	std::wstring_view MultiLocalizationManager::getLocalizedWideString(std::string_view localizationModuleName, std::string_view key, std::string_view language) const
-	{
-		if (localizationModuleName == defaultModuleName)
-		{
-			return WTextLocalization::get().getString(key, language);
+			current = it->second;
 		}
 
-		std::shared_lock<std::shared_mutex> lock(mapMutex);
-		auto it = localizations.find(localizationModuleName);
+		std::optional<std::string> previousBaseModuleName;
 
-		if (it == localizations.end())
+		if (auto it = overlayBases.find(overlayModuleName); it != overlayBases.end())
 		{
-			throw std::runtime_error(std::format("Can't find Localization holder with module name: {}", localizationModuleName));
+			previousBaseModuleName = it->second;
 		}
 
-		WTextLocalization& text = it->second->wlocalization;
+		overlayBases.insert_or_assign(overlayModuleName, baseModuleName);
 
-		return language.empty() ? text[key] : text.getString(key, language);
-	}
-#endif
+		try
+		{
+			this->rebuildOverlays(overlayModuleName);
+		}
+		catch (...)
+		{
+			if (previousBaseModuleName)
+			{
+				overlayBases.insert_or_assign(overlayModuleName, std::move(*previousBaseModuleName));
+			}
+			else
+			{
+				overlayBases.erase(overlayModuleName);
+			}
+
+			throw;
+		}
+	}
+
+	bool MultiLocalizationManager::removeOverlay(std::string_view overlayModuleName)
+	{
+		std::lock_guard<std::shared_mutex> lock(*mapMutex);
+
+		auto it = overlayBases.find(overlayModuleName);
+
+		if (it == overlayBases.end())
+		{
+			return false;
+		}
+
+		std::string baseModuleName = std::move(it->second);
+
+		overlayBases.erase(it);
+
+		try
+		{
+			this->rebuildOverlays(overlayModuleName);
+		}
+		catch (...)
+		{
+			overlayBases.try_emplace(std::string(overlayModuleName), std::move(baseModuleName));
+
+			throw;
+		}
+
+		return true;
+	}
+
+	void MultiLocalizationManager::startReverseIndex(const std::string& localizationModuleName, const TextLocalization& text)
+	{
+		// Index is declared after its arena, so it's destroyed first
+		struct ArenaReverseIndex
+		{
+			ModuleArena arena;
+			ReverseIndex index;
+
+			ArenaReverseIndex(const ModuleArena::Options& options, const TextLocalization& text, const UsageProfile::Module* usage) :
+				arena(options),
+				index(text, &arena, usage)
+			{
+
+			}
+		};
+
+		reverseIndexes.try_emplace
+		(
+			localizationModuleName,
+			std::make_unique<ReverseIndexBuild>
+			(
+				std::async
+				(
+					std::launch::async,
+					[&text, options = arenaOptions, usage = usageProfile->getModule(localizationModuleName)]() -> std::shared_ptr<const ReverseIndex>
+					{
+						std::shared_ptr<ArenaReverseIndex> result = std::make_shared<ArenaReverseIndex>(options, text, usage ? &*usage : nullptr);
+
+						// Returned pointer owns arena too
+						return std::shared_ptr<const ReverseIndex>(result, &result->index);
+					}
+				).share()
+			)
+		);
+	}
+
+	void MultiLocalizationManager::buildReverseIndex(const std::string& localizationModuleName)
+	{
+		std::lock_guard<std::shared_mutex> lock(*mapMutex);
+
+		if (reverseIndexes.contains(localizationModuleName))
+		{
+			return;
+		}
+
+		const TextLocalization* text = nullptr;
+
+		if (localizationModuleName == defaultModuleName)
+		{
+			text = &TextLocalization::get();
+		}
+		else if (auto it = localizations.find(localizationModuleName); it != localizations.end())
+		{
+			text = &it->second->localization;
+		}
+		else
+		{
+			throw std::runtime_error(std::format("Can't find Localization holder with module name: {}", localizationModuleName));
+		}
+
+		reverseIndexModules.emplace(localizationModuleName);
+
+		this->startReverseIndex(localizationModuleName, *text);
+	}
+
+	bool MultiLocalizationManager::dropReverseIndex(std::string_view localizationModuleName)
+	{
+		std::unique_ptr<ReverseIndexBuild> reverseIndex;
+
+		{
+			std::lock_guard<std::shared_mutex> lock(*mapMutex);
+
+			auto it = reverseIndexes.find(localizationModuleName);
+
+			if (it == reverseIndexes.end())
+			{
+				return false;
+			}
+
+			reverseIndex = std::move(it->second);
+
+			reverseIndexes.erase(it);
+
+			if (auto moduleIterator = reverseIndexModules.find(localizationModuleName); moduleIterator != reverseIndexModules.end())
+			{
+				reverseIndexModules.erase(moduleIterator);
+			}
+		}
+
+		// Background build finishes without blocking readers
+		reverseIndex->result.wait();
+
+		return true;
+	}
+
+	std::shared_ptr<const ReverseIndex> MultiLocalizationManager::getReverseIndex(std::string_view localizationModuleName, bool wait) const
+	{
+		std::shared_future<std::shared_ptr<const ReverseIndex>> reverseIndex;
+
+		{
+			std::shared_lock<std::shared_mutex> lock(*mapMutex);
+
+			auto it = reverseIndexes.find(localizationModuleName);
+
+			if (it == reverseIndexes.end())
+			{
+				return nullptr;
+			}
+
+			reverseIndex = it->second->result;
+		}
+
+		if (!wait && reverseIndex.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+		{
+			return nullptr;
+		}
+
+		return reverseIndex.get();
+	}
+
+	std::vector<NormalizedKeyIndex::Ambiguity> MultiLocalizationManager::setKeyNormalization(const std::string& localizationModuleName, KeyNormalization normalization)
+	{
+		std::lock_guard<std::shared_mutex> lock(*mapMutex);
+		const TextLocalization* text = nullptr;
+		std::unique_ptr<NormalizedKeyIndex>* normalizedKeys = nullptr;
+		// Default module index uses default resource
+		std::unique_ptr<ModuleArena>* normalizedKeysArena = nullptr;
+
+		if (localizationModuleName == defaultModuleName)
+		{
+			text = &TextLocalization::get();
+			normalizedKeys = &defaultNormalizedKeys;
+		}
+		else if (auto it = localizations.find(localizationModuleName); it != localizations.end())
+		{
+			text = &it->second->localization;
+			normalizedKeys = &it->second->normalizedKeys;
+			normalizedKeysArena = &it->second->normalizedKeysArena;
+		}
+		else
+		{
+			throw std::runtime_error(std::format("Can't find Localization holder with module name: {}", localizationModuleName));
+		}
+
+		this->buildNormalizedKeys(localizationModuleName, *text, normalization, *normalizedKeys, normalizedKeysArena);
+
+		if (normalization == KeyNormalization::none)
+		{
+			keyNormalizations.erase(localizationModuleName);
+		}
+		else
+		{
+			keyNormalizations.insert_or_assign(localizationModuleName, normalization);
+		}
+
+		this->invalidateMessages(localizationModuleName);
+
+		defaultKeyNormalization.store(static_cast<bool>(defaultNormalizedKeys), std::memory_order_release);
+
+		return *normalizedKeys ? (*normalizedKeys)->getAmbiguities() : std::vector<NormalizedKeyIndex::Ambiguity>();
+	}
+
+	std::vector<NormalizedKeyIndex::Ambiguity> MultiLocalizationManager::getKeyAmbiguities(std::string_view localizationModuleName) const
+	{
+		std::shared_lock<std::shared_mutex> lock(*mapMutex);
+		const NormalizedKeyIndex* normalizedKeys = nullptr;
+
+		if (localizationModuleName == defaultModuleName)
+		{
+			normalizedKeys = defaultNormalizedKeys.get();
+		}
+		else if (auto it = localizations.find(localizationModuleName); it != localizations.end())
+		{
+			normalizedKeys = it->second->normalizedKeys.get();
+		}
+
+		return normalizedKeys ? normalizedKeys->getAmbiguities() : std::vector<NormalizedKeyIndex::Ambiguity>();
+	}
+
+	size_t MultiLocalizationManager::enableNumaReplicas(const std::string& localizationModuleName)
+	{
+		std::lock_guard<std::shared_mutex> lock(*mapMutex);
+		const TextLocalization* text = nullptr;
+		const NumaReplicas** replicas = nullptr;
+		std::vector<std::unique_ptr<NumaReplicas>>* builtReplicas = nullptr;
+
+		if (localizationModuleName == defaultModuleName)
+		{
+			text = &TextLocalization::get();
+			replicas = &defaultReplicas;
+			builtReplicas = &defaultBuiltReplicas;
+		}
+		else if (auto it = localizations.find(localizationModuleName); it != localizations.end())
+		{
+			text = &it->second->localization;
+			replicas = &it->second->replicas;
+			builtReplicas = &it->second->builtReplicas;
+		}
+		else
+		{
+			throw std::runtime_error(std::format("Can't find Localization holder with module name: {}", localizationModuleName));
+		}
+
+		replicatedModules.insert(localizationModuleName);
+
+		this->updateReplicas(localizationModuleName, *text, *replicas, *builtReplicas);
+
+		defaultReplication.store(static_cast<bool>(defaultReplicas), std::memory_order_release);
+
+		return (*replicas)->getReplicasCount();
+	}
+
+	bool MultiLocalizationManager::disableNumaReplicas(std::string_view localizationModuleName)
+	{
+		std::lock_guard<std::shared_mutex> lock(*mapMutex);
+		auto replicatedIterator = replicatedModules.find(localizationModuleName);
+
+		if (replicatedIterator == replicatedModules.end())
+		{
+			return false;
+		}
+
+		replicatedModules.erase(replicatedIterator);
+
+		if (localizationModuleName == defaultModuleName)
+		{
+			this->updateReplicas(localizationModuleName, TextLocalization::get(), defaultReplicas, defaultBuiltReplicas);
+
+			defaultReplication.store(static_cast<bool>(defaultReplicas), std::memory_order_release);
+		}
+		else if (auto it = localizations.find(localizationModuleName); it != localizations.end())
+		{
+			this->updateReplicas(localizationModuleName, it->second->localization, it->second->replicas, it->second->builtReplicas);
+		}
+
+		return true;
+	}
+
+	void MultiLocalizationManager::startUsageRecording()
+	{
+		std::lock_guard<std::shared_mutex> lock(*mapMutex);
+
+		if (usageRecording.load(std::memory_order_relaxed))
+		{
+			return;
+		}
+
+		defaultUsage = std::make_unique<UsageRecorder>(TextLocalization::get());
+
+		for (auto& [_, holder] : localizations)
+		{
+			holder->usageArena = std::make_unique<ModuleArena>(arenaOptions);
+			holder->usage = std::make_unique<UsageRecorder>(holder->localization, holder->usageArena.get());
+		}
+
+		usageRecording.store(true, std::memory_order_release);
+	}
+
+	UsageProfile MultiLocalizationManager::stopUsageRecording()
+	{
+		std::lock_guard<std::shared_mutex> lock(*mapMutex);
+		UsageProfile result;
+
+		usageRecording.store(false, std::memory_order_release);
+
+		if (defaultUsage)
+		{
+			defaultUsage->collect(defaultModuleName, result);
+
+			defaultUsage.reset();
+		}
+
+		for (auto& [name, holder] : localizations)
+		{
+			if (holder->usage)
+			{
+				holder->usage->collect(name, result);
+
+				// Recorder is destroyed before its arena is released
+				holder->usage.reset();
+				holder->usageArena.reset();
+			}
+		}
+
+		return result;
+	}
+
+	UsageProfile MultiLocalizationManager::getRecordedUsage() const
+	{
+		std::shared_lock<std::shared_mutex> lock(*mapMutex);
+		UsageProfile result;
+
+		if (defaultUsage)
+		{
+			defaultUsage->collect(defaultModuleName, result);
+		}
+
+		for (const auto& [name, holder] : localizations)
+		{
+			if (holder->usage)
+			{
+				holder->usage->collect(name, result);
+			}
+		}
+
+		return result;
+	}
+
+	void MultiLocalizationManager::setUsageProfile(const UsageProfile& profile)
+	{
+		std::vector<std::unique_ptr<ReverseIndexBuild>> previousReverseIndexes;
+
+		{
+			std::lock_guard<std::shared_mutex> lock(*mapMutex);
+			std::unique_ptr<UsageProfile> previousProfile = std::exchange(usageProfile, std::make_unique<UsageProfile>(profile));
+
+			// Only structures of modules with changed restrictions are rebuilt
+			auto rebuild = [this, &previousProfile, &previousReverseIndexes](const std::string& name, const TextLocalization& text, std::unique_ptr<NormalizedKeyIndex>& normalizedKeys, std::unique_ptr<ModuleArena>* normalizedKeysArena) -> bool
+				{
+					if (previousProfile->getModule(name) == usageProfile->getModule(name))
+					{
+						return false;
+					}
+
+					if (auto it = keyNormalizations.find(name); it != keyNormalizations.end())
+					{
+						this->buildNormalizedKeys(name, text, it->second, normalizedKeys, normalizedKeysArena);
+					}
+
+					// Previous build reads module, so it's awaited after unlock
+					if (auto it = reverseIndexes.find(name); it != reverseIndexes.end())
+					{
+						previousReverseIndexes.push_back(std::move(it->second));
+
+						reverseIndexes.erase(it);
+
+						this->startReverseIndex(name, text);
+					}
+
+					this->invalidateMessages(name);
+
+					return true;
+				};
+
+			this->updateReplicas(defaultModuleName, TextLocalization::get(), defaultReplicas, defaultBuiltReplicas);
+
+			defaultReplication.store(static_cast<bool>(defaultReplicas), std::memory_order_release);
+
+			rebuild(defaultModuleName, TextLocalization::get(), defaultNormalizedKeys, nullptr);
+
+			for (auto& [name, holder] : localizations)
+			{
+				this->updateReplicas(name, holder->localization, holder->replicas, holder->builtReplicas);
+
+				if (!rebuild(name, holder->localization, holder->normalizedKeys, &holder->normalizedKeysArena))
+				{
+					continue;
+				}
+
+#ifndef __LINUX__
+				std::unique_ptr<ModuleArena> wideArena = std::make_unique<ModuleArena>(arenaOptions);
+				WTextLocalization wlocalization(holder->localization, wideArena.get(), usageProfile.get(), name);
+
+				// Values returned from previous dictionaries may still be used
+				holder->retiredWideLocalizations.push_back({ std::move(holder->wideArena), std::unique_ptr<WTextLocalization>(new WTextLocalization(std::move(holder->wlocalization))) });
+
+				holder->wlocalization = std::move(wlocalization);
+				holder->wideArena = std::move(wideArena);
+#endif
+			}
+
+			// Layers of overlay may be restricted differently, so all tables are rebuilt
+			this->rebuildOverlays("");
+		}
+
+		for (const std::unique_ptr<ReverseIndexBuild>& reverseIndex : previousReverseIndexes)
+		{
+			reverseIndex->result.wait();
+		}
+	}
+
+	UsageProfile MultiLocalizationManager::getUsageProfile() const
+	{
+		std::shared_lock<std::shared_mutex> lock(*mapMutex);
+
+		return *usageProfile;
+	}
+
+	size_t MultiLocalizationManager::releaseRetired()
+	{
+		std::vector<std::unique_ptr<NumaReplicas>> retired;
+#ifdef __LINUX__
+		std::vector<std::unique_ptr<SharedDictionary>> detached;
+#else
+		std::vector<LocalizationHolder::RetiredWideLocalization> retiredWide;
+#endif
+		size_t result = 0;
+
+		auto retire = [&retired](const NumaReplicas* replicas, std::vector<std::unique_ptr<NumaReplicas>>& builtReplicas)
+			{
+				for (std::unique_ptr<NumaReplicas>& built : builtReplicas)
+				{
+					if (built.get() != replicas)
+					{
+						retired.push_back(std::move(built));
+					}
+				}
+
+				std::erase(builtReplicas, nullptr);
+			};
+
+		{
+			std::lock_guard<std::shared_mutex> lock(*mapMutex);
+
+			retire(defaultReplicas, defaultBuiltReplicas);
+
+			for (auto& [_, holder] : localizations)
+			{
+				retire(holder->replicas, holder->builtReplicas);
+
+#ifndef __LINUX__
+				std::move(holder->retiredWideLocalizations.begin(), holder->retiredWideLocalizations.end(), std::back_inserter(retiredWide));
+
+				holder->retiredWideLocalizations.clear();
+#endif
+			}
+
+#ifdef __LINUX__
+			for (auto& [_, sharedModule] : sharedModules)
+			{
+				result += sharedModule->releasePrevious();
+			}
+
+			detached.swap(detachedSharedModules);
+#endif
+		}
+
+		// Copies are unreachable, so they are unmapped without blocking readers
+		for (const std::unique_ptr<NumaReplicas>& replicas : retired)
+		{
+			result += replicas->getMemoryUsage();
+		}
+
+#ifdef __LINUX__
+		for (const std::unique_ptr<SharedDictionary>& sharedModule : detached)
+		{
+			result += sharedModule->getMemoryUsage();
+		}
+#else
+		for (const LocalizationHolder::RetiredWideLocalization& wide : retiredWide)
+		{
+			result += wide.arena->getStatistics().reservedBytes;
+		}
+#endif
+
+		return result;
+	}
+
+	void MultiLocalizationManager::enableMessageCache(size_t capacity, size_t shardsCount)
+	{
+		std::unique_ptr<MessageCache> cache = std::make_unique<MessageCache>(capacity, shardsCount);
+		std::lock_guard<std::shared_mutex> lock(*mapMutex);
+
+		messageCaches.push_back(std::move(cache));
+
+		if (MessageCache* previous = messageCache.exchange(messageCaches.back().get(), std::memory_order_acq_rel))
+		{
+			previous->clear();
+		}
+	}
+
+	void MultiLocalizationManager::disableMessageCache()
+	{
+		std::lock_guard<std::shared_mutex> lock(*mapMutex);
+
+		if (MessageCache* previous = messageCache.exchange(nullptr, std::memory_order_acq_rel))
+		{
+			previous->clear();
+		}
+	}
+
+	MessageCache::Statistics MultiLocalizationManager::getMessageCacheStatistics() const
+	{
+		MessageCache* cache = messageCache.load(std::memory_order_acquire);
+
+		return cache ? cache->getStatistics() : MessageCache::Statistics();
+	}
+
+#ifdef __LINUX__
+	uint64_t MultiLocalizationManager::publishSharedModule(std::string_view localizationModuleName, std::string_view segmentName)
+	{
+		if (localizationModuleName == defaultModuleName)
+		{
+			return SharedDictionary::publish(TextLocalization::get(), segmentName);
+		}
+
+		std::shared_lock<std::shared_mutex> lock(*mapMutex);
+		auto it = localizations.find(localizationModuleName);
+
+		if (it == localizations.end())
+		{
+			throw std::runtime_error(std::format("Can't find Localization holder with module name: {}", localizationModuleName));
+		}
+
+		return SharedDictionary::publish(it->second->localization, segmentName);
+	}
+
+	void MultiLocalizationManager::attachSharedModule(const std::string& localizationModuleName, std::string_view segmentName)
+	{
+		if (localizationModuleName == defaultModuleName)
+		{
+			throw std::runtime_error(std::format("localizationModuleName can't be {}", defaultModuleName));
+		}
+
+		std::unique_ptr<SharedDictionary> sharedModule = std::make_unique<SharedDictionary>(segmentName);
+		std::lock_guard<std::shared_mutex> lock(*mapMutex);
+
+		if (localizations.contains(localizationModuleName))
+		{
+			throw std::runtime_error(std::format("Module {} is already loaded", localizationModuleName));
+		}
+
+		detachedSharedModules.reserve(detachedSharedModules.size() + 1);
+
+		auto [it, inserted] = sharedModules.try_emplace(localizationModuleName, std::move(sharedModule));
+
+		if (!inserted)
+		{
+			std::swap(it->second, sharedModule);
+
+			detachedSharedModules.push_back(std::move(sharedModule));
+		}
+
+		this->invalidateMessages(localizationModuleName);
+	}
+
+	bool MultiLocalizationManager::detachSharedModule(std::string_view localizationModuleName)
+	{
+		std::lock_guard<std::shared_mutex> lock(*mapMutex);
+
+		auto it = sharedModules.find(localizationModuleName);
+
+		if (it == sharedModules.end())
+		{
+			return false;
+		}
+
+		detachedSharedModules.push_back(std::move(it->second));
+
+		sharedModules.erase(it);
+
+		this->invalidateMessages(localizationModuleName);
+
+		return true;
+	}
+
+	size_t MultiLocalizationManager::refreshSharedModules()
+	{
+		std::lock_guard<std::shared_mutex> lock(*mapMutex);
+		size_t result = 0;
+
+		for (auto& [name, sharedModule] : sharedModules)
+		{
+			if (sharedModule->refresh())
+			{
+				this->invalidateMessages(name);
+
+				result++;
+			}
+		}
+
+		return result;
+	}
+#endif
+
+	LocalizedValue MultiLocalizationManager::getValue(const TextLocalization& text, std::string_view localizationModuleName, std::string_view key, std::string_view language)
+	{
+		if (language.empty())
+		{
+			language = text.getCurrentLanguage();
+		}
+
+		// Untranslated values are empty
+		if (const char* value = text.dictionaries(key.data(), language.data()); value && *value)
+		{
+			return { value, localizationModuleName };
+		}
+
+		return { text.getString(key, text.getOriginalLanguage(), false), localizationModuleName, true };
+	}
+
+	std::string_view MultiLocalizationManager::resolveKey(const NormalizedKeyIndex* normalizedKeys, std::string_view key)
+	{
+		if (normalizedKeys)
+		{
+			if (const char* originalKey = normalizedKeys->find(key))
+			{
+				return originalKey;
+			}
+		}
+
+		return key;
+	}
+
+	LocalizedValue MultiLocalizationManager::getReplicaValue(const NumaReplicas& replicas, const TextLocalization& text, std::string_view localizationModuleName, std::string_view key, std::string_view language)
+	{
+		const DictionaryImage& image = replicas.getLocalImage();
+
+		if (language.empty())
+		{
+			language = text.getCurrentLanguage();
+		}
+
+		if (const char* value = image.find(key, language))
+		{
+			return { value, localizationModuleName };
+		}
+
+		// Copies pruned by usage profile don't have other keys
+		if (replicas.isPruned())
+		{
+			return MultiLocalizationManager::getValue(text, localizationModuleName, key, language);
+		}
+
+		return { image.getString(key, image.getOriginalLanguage(), false), localizationModuleName, true };
+	}
+
+	void MultiLocalizationManager::updateReplicas(std::string_view localizationModuleName, const TextLocalization& text, const NumaReplicas*& replicas, std::vector<std::unique_ptr<NumaReplicas>>& builtReplicas)
+	{
+		// Restricted module without replicas reads module data, so pruned copy wouldn't save memory
+		if (!replicatedModules.contains(localizationModuleName))
+		{
+			replicas = nullptr;
+
+			return;
+		}
+
+		std::optional<UsageProfile::Module> usage = usageProfile->getModule(localizationModuleName);
+		NumaTopology topology = NumaTopology::get();
+		const UsageProfile::Module* module = usage ? &*usage : nullptr;
+
+		// Other threads may still use values from previous copies, so they are kept until releaseRetired and reused
+		for (const std::unique_ptr<NumaReplicas>& built : builtReplicas)
+		{
+			if (built->isBuiltWith(topology, module))
+			{
+				replicas = built.get();
+
+				return;
+			}
+		}
+
+		replicas = builtReplicas.emplace_back(std::make_unique<NumaReplicas>(text, topology, arenaOptions, module)).get();
+	}
+
+	void MultiLocalizationManager::buildNormalizedKeys(std::string_view localizationModuleName, const TextLocalization& text, KeyNormalization normalization, std::unique_ptr<NormalizedKeyIndex>& normalizedKeys, std::unique_ptr<ModuleArena>* normalizedKeysArena)
+	{
+		if (normalization == KeyNormalization::none)
+		{
+			normalizedKeys.reset();
+
+			if (normalizedKeysArena)
+			{
+				normalizedKeysArena->reset();
+			}
+
+			return;
+		}
+
+		std::unique_ptr<ModuleArena> arena = normalizedKeysArena ? std::make_unique<ModuleArena>(arenaOptions) : nullptr;
+		std::unique_ptr<NormalizedKeyIndex> index = std::make_unique<NormalizedKeyIndex>(text, normalization, arena ? arena.get() : std::pmr::get_default_resource(), usageProfile.get(), localizationModuleName);
+
+		// Index returns keys from module memory, so previous index is destroyed before its arena is released
+		normalizedKeys = std::move(index);
+
+		if (normalizedKeysArena)
+		{
+			*normalizedKeysArena = std::move(arena);
+		}
+	}
+
+	void MultiLocalizationManager::destroyModule(LocalizationHolder* holder)
+	{
+		ModuleArena* arena = holder->arena;
+
+		holder->~LocalizationHolder();
+
+		delete arena;
+	}
+
+	void MultiLocalizationManager::recordUsage(std::string_view localizationModuleName, std::string_view key, std::string_view language, const LocalizedValue& result) const
+	{
+		std::shared_lock<std::shared_mutex> lock(*mapMutex);
+		const NormalizedKeyIndex* normalizedKeys = nullptr;
+		UsageRecorder* recorder = nullptr;
+
+		if (localizationModuleName == defaultModuleName)
+		{
+			normalizedKeys = defaultNormalizedKeys.get();
+		}
+		else if (auto it = localizations.find(localizationModuleName); it != localizations.end())
+		{
+			normalizedKeys = it->second->normalizedKeys.get();
+		}
+
+		// Overlay values are recorded in layer that provides them
+		if (result.module == defaultModuleName)
+		{
+			recorder = defaultUsage.get();
+		}
+		else if (auto it = localizations.find(result.module); it != localizations.end())
+		{
+			recorder = it->second->usage.get();
+		}
+
+		if (!recorder)
+		{
+			return;
+		}
+
+		if (language.empty())
+		{
+			language = this->getCurrentLanguage(localizationModuleName);
+		}
+
+		recorder->record(MultiLocalizationManager::resolveKey(normalizedKeys, key), result.fallback ? recorder->getOriginalLanguage() : language);
+	}
+
+	LocalizedValue MultiLocalizationManager::getInstrumentedLocalizedValue(std::string_view localizationModuleName, std::string_view key, std::string_view language) const
+	{
+		bool tracing = LookupTracer::isEnabled();
+		LocalizedValue result;
+
+		try
+		{
+			result = this->findLocalizedValue(localizationModuleName, key, language);
+		}
+		catch (const std::exception&)
+		{
+			if (tracing)
+			{
+				LookupTracer::record(localizationModuleName, language, key, LookupResult::miss);
+			}
+
+			throw;
+		}
+
+		if (tracing)
+		{
+			LookupTracer::record(localizationModuleName, language, key, result.fallback ? LookupResult::fallback : LookupResult::hit);
+		}
+
+		if (usageRecording.load(std::memory_order_relaxed))
+		{
+			this->recordUsage(localizationModuleName, key, language, result);
+		}
+
+		return result;
+	}
+
+	std::string_view MultiLocalizationManager::getLocalizedString(std::string_view localizationModuleName, std::string_view key, std::string_view language) const
+	{
+		if (LookupTracer::isEnabled() || usageRecording.load(std::memory_order_relaxed))
+		{
+			return this->getInstrumentedLocalizedValue(localizationModuleName, key, language).value;
+		}
+
+		if (localizationModuleName == defaultModuleName)
+		{
+			TextLocalization& text = TextLocalization::get();
+			std::shared_lock<std::shared_mutex> lock(*mapMutex, std::defer_lock);
+
+			if (defaultKeyNormalization.load(std::memory_order_acquire) || defaultReplication.load(std::memory_order_acquire))
+			{
+				lock.lock();
+
+				key = MultiLocalizationManager::resolveKey(defaultNormalizedKeys.get(), key);
+
+				if (defaultReplicas)
+				{
+					return MultiLocalizationManager::getReplicaValue(*defaultReplicas, text, defaultModuleName, key, language).value;
+				}
+			}
+
+			return language.empty() ? text[key] : text.getString(key, language);
+		}
+
+		std::shared_lock<std::shared_mutex> lock(*mapMutex);
+		auto it = localizations.find(localizationModuleName);
+
+		if (it == localizations.end())
+		{
+#ifdef __LINUX__
+			if (auto sharedIterator = sharedModules.find(localizationModuleName); sharedIterator != sharedModules.end())
+			{
+				return sharedIterator->second->getString(key, language);
+			}
+#endif
+
+			throw std::runtime_error(std::format("Can't find Localization holder with module name: {}", localizationModuleName));
+		}
+
+		TextLocalization& text = it->second->localization;
+
+		key = MultiLocalizationManager::resolveKey(it->second->normalizedKeys.get(), key);
+
+		if (const OverlayTable* overlay = it->second->overlay.get())
+		{
+			return overlay->getString(key, language.empty() ? text.getCurrentLanguage() : language).value;
+		}
+
+		if (const NumaReplicas* replicas = it->second->replicas)
+		{
+			return MultiLocalizationManager::getReplicaValue(*replicas, text, it->first, key, language).value;
+		}
+
+		return language.empty() ? text[key] : text.getString(key, language);
+	}
+
+	LocalizedValue MultiLocalizationManager::findLocalizedValue(std::string_view localizationModuleName, std::string_view key, std::string_view language) const
+	{
+		if (localizationModuleName == defaultModuleName)
+		{
+			std::shared_lock<std::shared_mutex> lock(*mapMutex, std::defer_lock);
+
+			if (defaultKeyNormalization.load(std::memory_order_acquire) || defaultReplication.load(std::memory_order_acquire))
+			{
+				lock.lock();
+
+				key = MultiLocalizationManager::resolveKey(defaultNormalizedKeys.get(), key);
+
+				if (defaultReplicas)
+				{
+					return MultiLocalizationManager::getReplicaValue(*defaultReplicas, TextLocalization::get(), defaultModuleName, key, language);
+				}
+			}
+
+			return MultiLocalizationManager::getValue(TextLocalization::get(), defaultModuleName, key, language);
+		}
+
+		std::shared_lock<std::shared_mutex> lock(*mapMutex);
+		auto it = localizations.find(localizationModuleName);
+
+		if (it == localizations.end())
+		{
+#ifdef __LINUX__
+			if (auto sharedIterator = sharedModules.find(localizationModuleName); sharedIterator != sharedModules.end())
+			{
+				const DictionaryImage& image = sharedIterator->second->getImage();
+
+				if (const char* value = image.find(key, language.empty() ? image.getOriginalLanguage() : language))
+				{
+					return { value, sharedIterator->first };
+				}
+
+				return { image.getString(key, image.getOriginalLanguage(), false), sharedIterator->first, true };
+			}
+#endif
+
+			throw std::runtime_error(std::format("Can't find Localization holder with module name: {}", localizationModuleName));
+		}
+
+		TextLocalization& text = it->second->localization;
+
+		key = MultiLocalizationManager::resolveKey(it->second->normalizedKeys.get(), key);
+
+		if (const OverlayTable* overlay = it->second->overlay.get())
+		{
+			return overlay->getString(key, language.empty() ? text.getCurrentLanguage() : language);
+		}
+
+		if (const NumaReplicas* replicas = it->second->replicas)
+		{
+			return MultiLocalizationManager::getReplicaValue(*replicas, text, it->first, key, language);
+		}
+
+		return MultiLocalizationManager::getValue(text, it->first, key, language);
+	}
+
+	LocalizedValue MultiLocalizationManager::getLocalizedValue(std::string_view localizationModuleName, std::string_view key, std::string_view language) const
+	{
+		if (LookupTracer::isEnabled() || usageRecording.load(std::memory_order_relaxed))
+		{
+			return this->getInstrumentedLocalizedValue(localizationModuleName, key, language);
+		}
+
+		return this->findLocalizedValue(localizationModuleName, key, language);
+	}
+
+	const LocaleData& MultiLocalizationManager::getLocaleData(std::string_view localizationModuleName, std::string_view language) const
+	{
+		const TextLocalization* text = nullptr;
+
+		if (localizationModuleName == defaultModuleName)
+		{
+			text = &TextLocalization::get();
+		}
+		else
+		{
+			std::shared_lock<std::shared_mutex> lock(*mapMutex);
+			auto it = localizations.find(localizationModuleName);
+
+			if (it == localizations.end())
+			{
+				throw std::runtime_error(std::format("Can't find Localization holder with module name: {}", localizationModuleName));
+			}
+
+			text = &it->second->localization;
+		}
+
+		return language.empty() ? text->getLocaleData() : text->getLocaleData(language);
+	}
+
+#ifndef __LINUX__
+	std::wstring_view MultiLocalizationManager::getLocalizedWideString(std::string_view localizationModuleName, std::string_view key, std::string_view language) const
+	{
+		if (localizationModuleName == defaultModuleName)
+		{
+			std::shared_lock<std::shared_mutex> lock(*mapMutex, std::defer_lock);
+
+			if (defaultKeyNormalization.load(std::memory_order_acquire))
+			{
+				lock.lock();
+
+				key = MultiLocalizationManager::resolveKey(defaultNormalizedKeys.get(), key);
+			}
+
+			return WTextLocalization::get().getString(key, language);
+		}
+
+		std::shared_lock<std::shared_mutex> lock(*mapMutex);
+		auto it = localizations.find(localizationModuleName);
+
+		if (it == localizations.end())
+		{
+			throw std::runtime_error(std::format("Can't find Localization holder with module name: {}", localizationModuleName));
+		}
+
+		WTextLocalization& text = it->second->wlocalization;
+
+		key = MultiLocalizationManager::resolveKey(it->second->normalizedKeys.get(), key);
+
+		if (const OverlayTable* overlay = it->second->overlay.get())
+		{
+			return overlay->getWideString(key, language.empty() ? text.getCurrentLanguage() : language);
+		}
+
+		return language.empty() ? text[key] : text.getString(key, language);
+	}
+#endif
+}
+
+std::vector<std::string> getStringsSetting(const json::JsonParser& settings, const std::string& key)
+{
+	try
+	{
+		return json::utility::JsonArrayWrapper(settings.get<std::vector<json::JsonObject>>(key)).as<std::string>();
+	}
+	catch (const json::exceptions::CantFindValueException&)
+	{
+		return {};
+	}
 }
@@ -0,0 +1,224 @@
+#include "NormalizedKeyIndex.h"
+
+#include <set>
+
+#include "UsageProfile.h"
+
+namespace
+{
+	/// @brief Produces normalized bytes of key one by one
+	class NormalizedReader
+	{
+	private:
+		std::string_view key;
+		localization::KeyNormalization normalization;
+		size_t index;
+		char buffer[2];
+		size_t bufferSize;
+		size_t bufferIndex;
+
+	private:
+		static bool isSeparator(char symbol)
+		{
+			switch (symbol)
+			{
+			case '.':
+			case '_':
+			case '-':
+			case '/':
+			case ':':
+			case ' ':
+				return true;
+
+			default:
+				return false;
+			}
+		}
+
+	public:
+		NormalizedReader(std::string_view key, localization::KeyNormalization normalization) :
+			key(key),
+			normalization(normalization),
+			index(0),
+			bufferSize(0),
+			bufferIndex(0)
+		{
+
+		}
+
+		/// @brief Next normalized byte or -1 at the end
+		int next()
+		{
+			if (bufferIndex < bufferSize)
+			{
+				return static_cast<uint8_t>(buffer[bufferIndex++]);
+			}
+
+			if (normalization & localization::KeyNormalization::ignoreSeparators)
+			{
+				while (index < key.size() && NormalizedReader::isSeparator(key[index]))
+				{
+					index++;
+				}
+			}
+
+			if (index == key.size())
+			{
+				return -1;
+			}
+
+			if (normalization & localization::KeyNormalization::foldCase)
+			{
+				bufferSize = localization::utility::foldSymbol(key, index, buffer);
+			}
+			else
+			{
+				buffer[0] = key[index];
+				bufferSize = 1;
+			}
+
+			index += bufferSize;
+			bufferIndex = 1;
+
+			return static_cast<uint8_t>(buffer[0]);
+		}
+	};
+}
+
+namespace localization
+{
+	size_t NormalizedKeyIndex::Hash::operator ()(std::string_view key) const noexcept
+	{
+		NormalizedReader reader(key, normalization);
+		uint64_t result = 14695981039346656037ULL;
+
+		for (int symbol = reader.next(); symbol != -1; symbol = reader.next())
+		{
+			result = (result ^ static_cast<uint64_t>(symbol)) * 1099511628211ULL;
+		}
+
+		return static_cast<size_t>(result);
+	}
+
+	bool NormalizedKeyIndex::Equal::operator ()(std::string_view left, std::string_view right) const noexcept
+	{
+		NormalizedReader leftReader(left, normalization);
+		NormalizedReader rightReader(right, normalization);
+
+		while (true)
+		{
+			int leftSymbol = leftReader.next();
+
+			if (leftSymbol != rightReader.next())
+			{
+				return false;
+			}
+
+			if (leftSymbol == -1)
+			{
+				return true;
+			}
+		}
+	}
+
+	NormalizedKeyIndex::NormalizedKeyIndex(const TextLocalization& localization, KeyNormalization normalization, std::pmr::memory_resource* resource, const UsageProfile* usage, std::string_view moduleName) :
+		normalization(normalization),
+		keys(0, Hash{ normalization }, Equal{ normalization }, resource),
+		prunedModule(nullptr)
+	{
+		std::optional<UsageProfile::Module> module = usage ? usage->getModule(moduleName) : std::nullopt;
+		std::set<std::string, std::less<>> originalKeys;
+
+		for (const std::string& language : localization.getLanguages())
+		{
+			localization.forEachString
+			(
+				language,
+				[&originalKeys](std::string_view key, std::string_view)
+				{
+					if (!originalKeys.contains(key))
+					{
+						originalKeys.emplace(key);
+					}
+				}
+			);
+		}
+
+		// Ambiguities are found among all keys, so pruned index resolves keys the same way
+		std::unordered_set<std::string_view, Hash, Equal> groups(originalKeys.size(), Hash{ normalization }, Equal{ normalization });
+		std::vector<std::string_view> indexedKeys;
+
+		for (const std::string& key : originalKeys)
+		{
+			if (auto [it, inserted] = groups.emplace(key); !inserted)
+			{
+				ambiguities.push_back({ std::string(*it), key });
+			}
+			else if (module && !module->isKeyUsed(key))
+			{
+				prunedModule = &localization;
+			}
+			else
+			{
+				indexedKeys.push_back(key);
+			}
+		}
+
+		keys.reserve(indexedKeys.size());
+
+		for (std::string_view key : indexedKeys)
+		{
+			keys.emplace(key);
+		}
+	}
+
+	const char* NormalizedKeyIndex::find(std::string_view key) const noexcept
+	{
+		if (auto it = keys.find(key); it != keys.end())
+		{
+			return it->data();
+		}
+
+		if (!prunedModule)
+		{
+			return nullptr;
+		}
+
+		try
+		{
+			Equal equal{ normalization };
+			const char* result = nullptr;
+
+			for (const std::string& language : prunedModule->getLanguages())
+			{
+				prunedModule->forEachString
+				(
+					language,
+					[&equal, &result, key](std::string_view originalKey, std::string_view)
+					{
+						if (equal(key, originalKey) && (!result || originalKey < result))
+						{
+							result = originalKey.data();
+						}
+					}
+				);
+			}
+
+			return result;
+		}
+		catch (const std::exception&)
+		{
+			return nullptr;
+		}
+	}
+
+	KeyNormalization NormalizedKeyIndex::getNormalization() const
+	{
+		return normalization;
+	}
+
+	const std::vector<NormalizedKeyIndex::Ambiguity>& NormalizedKeyIndex::getAmbiguities() const
+	{
+		return ambiguities;
+	}
+}
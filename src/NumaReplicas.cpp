@@ -0,0 +1,73 @@
+#include "NumaReplicas.h"
+
+#include <cstring>
+
+namespace localization
+{
+	NumaReplicas::NumaReplicas(const TextLocalization& localization, const NumaTopology& topology, ModuleArena::Options options, const UsageProfile::Module* usage) :
+		nodes(topology.getNodes())
+	{
+		if (usage)
+		{
+			this->usage = *usage;
+		}
+
+		std::vector<std::byte> image = DictionaryImage::build(localization, 0, usage);
+
+		arenas.reserve(topology.getNodesCount());
+		images.reserve(topology.getNodesCount());
+
+		for (uint32_t node : topology.getNodes())
+		{
+			options.node = topology.getNodesCount() == 1 ? -1 : static_cast<int32_t>(node);
+			options.chunkSize = image.size();
+
+			ModuleArena& arena = *arenas.emplace_back(std::make_unique<ModuleArena>(options));
+			// First write after mbind places pages on node
+			void* data = arena.allocate(image.size(), alignof(uint64_t));
+
+			std::memcpy(data, image.data(), image.size());
+
+			images.emplace_back(data);
+		}
+	}
+
+	const DictionaryImage& NumaReplicas::getLocalImage() const noexcept
+	{
+		size_t nodeIndex = NumaTopology::getCurrentNodeIndex();
+
+		return images[nodeIndex < images.size() ? nodeIndex : 0];
+	}
+
+	const DictionaryImage& NumaReplicas::getImage(size_t nodeIndex) const
+	{
+		return images.at(nodeIndex);
+	}
+
+	size_t NumaReplicas::getReplicasCount() const
+	{
+		return images.size();
+	}
+
+	size_t NumaReplicas::getMemoryUsage() const
+	{
+		size_t result = 0;
+
+		for (const std::unique_ptr<ModuleArena>& arena : arenas)
+		{
+			result += arena->getStatistics().reservedBytes;
+		}
+
+		return result;
+	}
+
+	bool NumaReplicas::isPruned() const
+	{
+		return usage.has_value();
+	}
+
+	bool NumaReplicas::isBuiltWith(const NumaTopology& topology, const UsageProfile::Module* usage) const
+	{
+		return nodes == topology.getNodes() && (usage ? this->usage == *usage : !this->usage);
+	}
+}
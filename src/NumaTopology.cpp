@@ -0,0 +1,144 @@
+#include "NumaTopology.h"
+
+#include <fstream>
+#include <string>
+#include <algorithm>
+
+#ifdef __LINUX__
+#include <sched.h>
+#endif
+
+namespace
+{
+	/// @brief Parse sysfs list like 0-3,8,10-11
+	/// @exception std::invalid_argument
+	/// @exception std::out_of_range
+	std::vector<uint32_t> readList(const std::filesystem::path& pathToList)
+	{
+		std::ifstream input(pathToList);
+		std::vector<uint32_t> result;
+		std::string line;
+
+		if (!std::getline(input, line))
+		{
+			throw std::invalid_argument(pathToList.string());
+		}
+
+		for (size_t start = 0; start < line.size();)
+		{
+			size_t end = std::min(line.find(',', start), line.size());
+			std::string range = line.substr(start, end - start);
+			size_t separator = range.find('-');
+			uint32_t first = static_cast<uint32_t>(std::stoul(range.substr(0, separator)));
+			uint32_t last = separator == std::string::npos ? first : static_cast<uint32_t>(std::stoul(range.substr(separator + 1)));
+
+			for (uint32_t value = first; value <= last; value++)
+			{
+				result.push_back(value);
+			}
+
+			start = end + 1;
+		}
+
+		return result;
+	}
+}
+
+namespace localization
+{
+	NumaTopology NumaTopology::read(const std::filesystem::path& pathToNodes)
+	{
+		NumaTopology result;
+
+		try
+		{
+			std::vector<uint32_t> nodes = readList(pathToNodes / "online");
+			std::vector<uint32_t> cpuNodes;
+
+			if (nodes.empty())
+			{
+				return result;
+			}
+
+			std::sort(nodes.begin(), nodes.end());
+
+			for (size_t i = 0; i < nodes.size(); i++)
+			{
+				for (uint32_t cpu : readList(pathToNodes / ("node" + std::to_string(nodes[i])) / "cpulist"))
+				{
+					if (cpu >= cpuNodes.size())
+					{
+						cpuNodes.resize(cpu + 1);
+					}
+
+					cpuNodes[cpu] = static_cast<uint32_t>(i);
+				}
+			}
+
+			result.nodes = std::move(nodes);
+			result.cpuNodes = std::move(cpuNodes);
+		}
+		catch (const std::exception&)
+		{
+			return NumaTopology();
+		}
+
+		return result;
+	}
+
+	const NumaTopology& NumaTopology::get()
+	{
+#ifdef __LINUX__
+		static const NumaTopology topology = NumaTopology::read();
+#else
+		static const NumaTopology topology;
+#endif
+
+		return topology;
+	}
+
+	size_t NumaTopology::getCurrentNodeIndex() noexcept
+	{
+		const NumaTopology& topology = NumaTopology::get();
+
+		if (topology.getNodesCount() == 1)
+		{
+			return 0;
+		}
+
+		thread_local size_t nodeIndex = 0;
+		thread_local uint32_t calls = 0;
+
+#ifdef __LINUX__
+		if (!(calls++ & 1023))
+		{
+			int cpu = sched_getcpu();
+
+			nodeIndex = cpu < 0 ? 0 : topology.getNodeIndex(static_cast<uint32_t>(cpu));
+		}
+#endif
+
+		return nodeIndex;
+	}
+
+	NumaTopology::NumaTopology() :
+		nodes({ 0 })
+	{
+
+	}
+
+	const std::vector<uint32_t>& NumaTopology::getNodes() const
+	{
+		return nodes;
+	}
+
+	size_t NumaTopology::getNodesCount() const
+	{
+		return nodes.size();
+	}
+
+	size_t NumaTopology::getNodeIndex(uint32_t cpu) const noexcept
+	{
+		return cpu < cpuNodes.size() ? cpuNodes[cpu] : 0;
+	}
+}
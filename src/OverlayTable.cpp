@@ -0,0 +1,144 @@
+#include "OverlayTable.h"
+
+#include <format>
+#include <unordered_set>
+
+#include "UsageProfile.h"
+
+namespace localization
+{
+	bool OverlayTable::findEntry(std::string_view key, std::string_view language, Entry& entry) const
+	{
+		if (auto languageIterator = dictionaries.find(language); languageIterator != dictionaries.end())
+		{
+			if (auto keyIterator = languageIterator->second.find(key); keyIterator != languageIterator->second.end())
+			{
+				entry = keyIterator->second;
+
+				return true;
+			}
+		}
+
+		if (pruned)
+		{
+			// Untranslated values are empty and don't hide values of lower layers
+			for (size_t i = layers.size(); i--;)
+			{
+				if (const char* value = layers[i].localization->find(key, language); value && *value)
+				{
+					entry = { value, i };
+
+					return true;
+				}
+			}
+		}
+
+		return false;
+	}
+
+	OverlayTable::Entry OverlayTable::find(std::string_view key, std::string_view& language, bool allowOriginal) const
+	{
+		Entry result;
+
+		if (this->findEntry(key, language, result))
+		{
+			return result;
+		}
+
+		if (!allowOriginal)
+		{
+			throw std::runtime_error(std::format(R"(Can't find key "{}" for {})", key, language));
+		}
+
+		if (this->findEntry(key, originalLanguage, result))
+		{
+			language = originalLanguage;
+
+			return result;
+		}
+
+		throw std::runtime_error(std::format(R"(Can't find key "{}" for {}, also can't find in original language {})", key, language, originalLanguage));
+	}
+
+	OverlayTable::OverlayTable(std::vector<Layer>&& layers, std::pmr::memory_resource* resource, const UsageProfile* usage) :
+		layers(std::move(layers)),
+		dictionaries(resource),
+		pruned(false)
+	{
+		if (this->layers.empty())
+		{
+			throw std::runtime_error("Overlays chain can't be empty");
+		}
+
+		originalLanguage = this->layers.back().localization->getOriginalLanguage();
+
+		// Keys of upper layers that profile doesn't allow, they still hide the same keys of lower layers
+		std::unordered_map<std::string, std::unordered_set<std::string, utility::StringViewHash, utility::StringViewEqual>, utility::StringViewHash, utility::StringViewEqual> prunedKeys;
+
+		// Upper layers are merged first, so each value is inserted once
+		for (size_t i = this->layers.size(); i--;)
+		{
+			const TextLocalization& localization = *this->layers[i].localization;
+			std::optional<UsageProfile::Module> module = usage ? usage->getModule(this->layers[i].name) : std::nullopt;
+
+			for (const std::string& language : localization.getLanguages())
+			{
+				auto it = dictionaries.find(language);
+
+				if (it == dictionaries.end())
+				{
+					it = dictionaries.try_emplace(std::pmr::string(language, resource)).first;
+				}
+
+				Dictionary& dictionary = it->second;
+				std::unordered_set<std::string, utility::StringViewHash, utility::StringViewEqual>& languagePrunedKeys = prunedKeys[language];
+				bool isOriginal = language == originalLanguage;
+
+				localization.forEachString
+				(
+					language,
+					[this, &dictionary, &languagePrunedKeys, &module, &language, resource, isOriginal, i](std::string_view key, std::string_view value)
+					{
+						if (dictionary.contains(key) || languagePrunedKeys.contains(key))
+						{
+							return;
+						}
+
+						if (module && !module->isKeyAllowed(language, key) && !(isOriginal && module->isKeyUsed(key)))
+						{
+							languagePrunedKeys.emplace(key);
+
+							pruned = true;
+
+							return;
+						}
+
+						dictionary.try_emplace(std::pmr::string(key, resource), Entry{ value, i });
+					}
+				);
+			}
+		}
+	}
+
+	const std::vector<OverlayTable::Layer>& OverlayTable::getLayers() const
+	{
+		return layers;
+	}
+
+	LocalizedValue OverlayTable::getString(std::string_view key, std::string_view language, bool allowOriginal) const
+	{
+		std::string_view requestedLanguage = language;
+		Entry entry = this->find(key, language, allowOriginal);
+
+		return { entry.value, layers[entry.layer].name, language != requestedLanguage };
+	}
+
+#ifndef __LINUX__
+	std::wstring_view OverlayTable::getWideString(std::string_view key, std::string_view language, bool allowOriginal) const
+	{
+		Entry entry = this->find(key, language, allowOriginal);
+
+		return layers[entry.layer].wlocalization->getString(key, language, false);
+	}
+#endif
+}
@@ -0,0 +1,227 @@
+#include "ReverseIndex.h"
+
+#include <algorithm>
+#include <iterator>
+#include <format>
+
+namespace
+{
+	uint32_t makeTrigram(const char* data)
+	{
+		return static_cast<uint32_t>(static_cast<uint8_t>(data[0])) << 16 | static_cast<uint32_t>(static_cast<uint8_t>(data[1])) << 8 | static_cast<uint8_t>(data[2]);
+	}
+}
+
+namespace localization
+{
+	ReverseIndex::Language::Language(const allocator_type& allocator) :
+		name(allocator),
+		documents(allocator),
+		values(allocator),
+		postings(allocator)
+	{
+
+	}
+
+	ReverseIndex::Language::Language(Language&& other, const allocator_type& allocator) :
+		name(std::move(other.name), allocator),
+		documents(std::move(other.documents), allocator),
+		values(std::move(other.values), allocator),
+		postings(std::move(other.postings), allocator)
+	{
+
+	}
+
+	void ReverseIndex::find(const Language& language, std::string_view text, std::string_view foldedText, bool ignoreCase, std::vector<uint32_t>& result) const
+	{
+		std::string_view pattern = ignoreCase ? foldedText : text;
+		std::vector<uint32_t> candidates;
+		bool all = foldedText.size() < 3;
+
+		if (!all)
+		{
+			std::vector<const std::pmr::vector<uint32_t>*> lists;
+
+			for (size_t i = 0; i + 3 <= foldedText.size(); i++)
+			{
+				auto it = language.postings.find(makeTrigram(foldedText.data() + i));
+
+				if (it == language.postings.end())
+				{
+					return;
+				}
+
+				lists.push_back(&it->second);
+			}
+
+			std::sort(lists.begin(), lists.end(), [](const std::pmr::vector<uint32_t>* left, const std::pmr::vector<uint32_t>* right) { return std::make_pair(left->size(), left) < std::make_pair(right->size(), right); });
+
+			lists.erase(std::unique(lists.begin(), lists.end()), lists.end());
+
+			candidates.assign(lists.front()->begin(), lists.front()->end());
+
+			for (size_t i = 1; i < lists.size() && candidates.size(); i++)
+			{
+				std::vector<uint32_t> intersection;
+
+				std::set_intersection(candidates.begin(), candidates.end(), lists[i]->begin(), lists[i]->end(), std::back_inserter(intersection));
+
+				candidates = std::move(intersection);
+			}
+		}
+
+		size_t count = all ? language.documents.size() : candidates.size();
+
+		for (size_t i = 0; i < count; i++)
+		{
+			const Document& document = language.documents[all ? i : candidates[i]];
+			size_t offset = ignoreCase ? language.values.size() / 2 + document.valueOffset : document.valueOffset;
+
+			if (std::string_view(language.values.data() + offset, document.valueSize).find(pattern) != std::string_view::npos)
+			{
+				result.push_back(document.key);
+			}
+		}
+	}
+
+	ReverseIndex::ReverseIndex(const TextLocalization& localization, std::pmr::memory_resource* resource, const UsageProfile::Module* usage) :
+		keys(resource),
+		languages(resource),
+		memoryUsage(0)
+	{
+		std::unordered_map<std::string_view, uint32_t, utility::StringViewHash, utility::StringViewEqual> keyIds;
+		std::vector<std::string_view> indexedKeys;
+		std::vector<std::string> names = localization.getLanguages();
+		std::string_view originalLanguage = localization.getOriginalLanguage();
+
+		languages.reserve(names.size());
+
+		for (const std::string& name : names)
+		{
+			// Languages that profile doesn't allow stay empty, so they are still valid in queries
+			bool isOriginal = name == originalLanguage;
+			std::vector<Document> documents;
+			std::string values;
+			std::unordered_map<uint32_t, std::vector<uint32_t>> postings;
+
+			localization.forEachString
+			(
+				name,
+				[&documents, &values, &keyIds, &indexedKeys, &name, usage, isOriginal](std::string_view key, std::string_view value)
+				{
+					if (usage && !usage->isKeyAllowed(name, key) && !(isOriginal && usage->isKeyUsed(key)))
+					{
+						return;
+					}
+
+					auto [it, inserted] = keyIds.try_emplace(key, static_cast<uint32_t>(indexedKeys.size()));
+
+					if (inserted)
+					{
+						indexedKeys.push_back(key);
+					}
+
+					documents.push_back({ it->second, static_cast<uint32_t>(values.size()), static_cast<uint32_t>(value.size()) });
+					values.append(value);
+				}
+			);
+
+			values += utility::foldCase(values);
+
+			std::string_view folded = std::string_view(values).substr(values.size() / 2);
+
+			for (uint32_t i = 0; i < documents.size(); i++)
+			{
+				const Document& document = documents[i];
+
+				for (uint32_t j = 0; j + 3 <= document.valueSize; j++)
+				{
+					std::vector<uint32_t>& posting = postings[makeTrigram(folded.data() + document.valueOffset + j)];
+
+					if (posting.empty() || posting.back() != i)
+					{
+						posting.push_back(i);
+					}
+				}
+			}
+
+			// Copies have exact sizes
+			Language& language = languages.emplace_back();
+
+			language.name = name;
+			language.documents.assign(documents.begin(), documents.end());
+			language.values = values;
+			language.postings.reserve(postings.size());
+
+			for (const auto& [trigram, posting] : postings)
+			{
+				language.postings.try_emplace(trigram, posting.begin(), posting.end());
+			}
+
+			memoryUsage += language.name.capacity() + language.documents.capacity() * sizeof(Document) + language.values.capacity();
+			memoryUsage += language.postings.bucket_count() * sizeof(void*);
+
+			for (const auto& [_, posting] : language.postings)
+			{
+				// Node with trigram, vector and next pointer
+				memoryUsage += sizeof(void*) + sizeof(std::pair<uint32_t, std::pmr::vector<uint32_t>>) + posting.capacity() * sizeof(uint32_t);
+			}
+		}
+
+		keys.reserve(indexedKeys.size());
+
+		// Keys point to module memory, so index copies them
+		for (std::string_view key : indexedKeys)
+		{
+			const std::pmr::string& copy = keys.emplace_back(key);
+
+			memoryUsage += sizeof(std::pmr::string) + (copy.size() >= sizeof(std::pmr::string) ? copy.capacity() : 0);
+		}
+
+		memoryUsage += languages.capacity() * sizeof(Language);
+	}
+
+	std::vector<std::string_view> ReverseIndex::find(std::string_view text, std::string_view language, bool ignoreCase) const
+	{
+		std::string foldedText = utility::foldCase(text);
+		std::vector<uint32_t> keysIndices;
+		std::vector<std::string_view> result;
+
+		if (language.empty())
+		{
+			for (const Language& current : languages)
+			{
+				this->find(current, text, foldedText, ignoreCase, keysIndices);
+			}
+		}
+		else
+		{
+			auto it = std::find_if(languages.begin(), languages.end(), [language](const Language& current) { return current.name == language; });
+
+			if (it == languages.end())
+			{
+				throw std::runtime_error(std::format(R"(Wrong language value "{}")", language));
+			}
+
+			this->find(*it, text, foldedText, ignoreCase, keysIndices);
+		}
+
+		result.reserve(keysIndices.size());
+
+		for (uint32_t index : keysIndices)
+		{
+			result.push_back(keys[index]);
+		}
+
+		std::sort(result.begin(), result.end());
+
+		result.erase(std::unique(result.begin(), result.end()), result.end());
+
+		return result;
+	}
+
+	size_t ReverseIndex::getMemoryUsage() const
+	{
+		return memoryUsage;
+	}
+}
@@ -0,0 +1,347 @@
+#ifdef __LINUX__
+
+#include "SharedDictionary.h"
+
+#include <atomic>
+#include <cstring>
+#include <cerrno>
+#include <format>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/file.h>
+
+namespace
+{
+	/// @brief LOCSHMCT
+	constexpr uint64_t controlMagic = 0x54434D4853434F4CULL;
+	constexpr int maxMapAttempts = 16;
+
+	struct Control
+	{
+		uint64_t magic;
+		std::atomic<uint64_t> generation;
+	};
+
+	static_assert(std::atomic<uint64_t>::is_always_lock_free);
+
+	std::string getSegmentName(std::string_view name, uint64_t generation)
+	{
+		return std::format("{}.{}", name, generation);
+	}
+
+	const Control* getControl(const void* control)
+	{
+		return static_cast<const Control*>(control);
+	}
+}
+
+namespace localization
+{
+	bool SharedDictionary::map(uint64_t generation)
+	{
+		// Mapped generation is never lost after successful mmap
+		previousMappings.reserve(previousMappings.size() + 1);
+
+		int descriptor = shm_open(getSegmentName(name, generation).data(), O_RDONLY, 0);
+
+		if (descriptor == -1)
+		{
+			if (errno == ENOENT)
+			{
+				return false;
+			}
+
+			throw std::runtime_error(std::format("Can't open shared memory segment {}: {}", getSegmentName(name, generation), std::strerror(errno)));
+		}
+
+		struct stat status = {};
+
+		if (fstat(descriptor, &status) == -1 || !status.st_size)
+		{
+			close(descriptor);
+
+			throw std::runtime_error(std::format("Can't get size of shared memory segment {}", getSegmentName(name, generation)));
+		}
+
+		void* data = mmap(nullptr, status.st_size, PROT_READ, MAP_SHARED, descriptor, 0);
+
+		close(descriptor);
+
+		if (data == MAP_FAILED)
+		{
+			throw std::runtime_error(std::format("Can't map shared memory segment {}: {}", getSegmentName(name, generation), std::strerror(errno)));
+		}
+
+		if (!DictionaryImage::isValid(data, status.st_size) || DictionaryImage(data).getGeneration() != generation)
+		{
+			munmap(data, status.st_size);
+
+			throw std::runtime_error(std::format("Shared memory segment {} has wrong format", getSegmentName(name, generation)));
+		}
+
+		if (mapping.data)
+		{
+			previousMappings.push_back(mapping);
+		}
+
+		mapping = { data, static_cast<size_t>(status.st_size) };
+		image = DictionaryImage(data);
+
+		return true;
+	}
+
+	void SharedDictionary::mapPublished()
+	{
+		for (int i = 0; i < maxMapAttempts; i++)
+		{
+			// Publisher can unlink generation between load and shm_open, then newer generation is already visible
+			if (this->map(this->getPublishedGeneration()))
+			{
+				return;
+			}
+		}
+
+		throw std::runtime_error(std::format("Can't map published generation of {}", name));
+	}
+
+	void SharedDictionary::unmap()
+	{
+		this->releasePrevious();
+
+		if (mapping.data)
+		{
+			munmap(const_cast<void*>(mapping.data), mapping.size);
+
+			mapping = {};
+			image = DictionaryImage();
+		}
+	}
+
+	uint64_t SharedDictionary::publish(const TextLocalization& localization, std::string_view name)
+	{
+		std::string controlName(name);
+		int controlDescriptor = shm_open(controlName.data(), O_CREAT | O_RDWR, 0644);
+
+		if (controlDescriptor == -1)
+		{
+			throw std::runtime_error(std::format("Can't create shared memory segment {}: {}", name, std::strerror(errno)));
+		}
+
+		// Serialize concurrent publishers
+		flock(controlDescriptor, LOCK_EX);
+
+		struct stat status = {};
+		Control* control = nullptr;
+
+		if (fstat(controlDescriptor, &status) == -1 || (status.st_size < static_cast<off_t>(sizeof(Control)) && ftruncate(controlDescriptor, sizeof(Control)) == -1))
+		{
+			close(controlDescriptor);
+
+			throw std::runtime_error(std::format("Can't resize shared memory segment {}: {}", name, std::strerror(errno)));
+		}
+
+		control = static_cast<Control*>(mmap(nullptr, sizeof(Control), PROT_READ | PROT_WRITE, MAP_SHARED, controlDescriptor, 0));
+
+		if (control == MAP_FAILED)
+		{
+			close(controlDescriptor);
+
+			throw std::runtime_error(std::format("Can't map shared memory segment {}: {}", name, std::strerror(errno)));
+		}
+
+		control->magic = controlMagic;
+
+		uint64_t generation = control->generation.load(std::memory_order_acquire) + 1;
+		std::string segmentName = getSegmentName(name, generation);
+		std::vector<std::byte> image = DictionaryImage::build(localization, generation);
+
+		shm_unlink(segmentName.data());
+
+		int descriptor = shm_open(segmentName.data(), O_CREAT | O_EXCL | O_RDWR, 0644);
+		void* data = MAP_FAILED;
+
+		if (descriptor != -1 && ftruncate(descriptor, image.size()) != -1)
+		{
+			data = mmap(nullptr, image.size(), PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+		}
+
+		if (data == MAP_FAILED)
+		{
+			std::string error = std::strerror(errno);
+
+			if (descriptor != -1)
+			{
+				close(descriptor);
+
+				shm_unlink(segmentName.data());
+			}
+
+			munmap(control, sizeof(Control));
+			close(controlDescriptor);
+
+			throw std::runtime_error(std::format("Can't create shared memory segment {}: {}", segmentName, error));
+		}
+
+		std::memcpy(data, image.data(), image.size());
+
+		munmap(data, image.size());
+		close(descriptor);
+
+		control->generation.store(generation, std::memory_order_release);
+
+		if (generation > 1)
+		{
+			// Attached processes keep previous generation until refresh
+			shm_unlink(getSegmentName(name, generation - 1).data());
+		}
+
+		munmap(control, sizeof(Control));
+		close(controlDescriptor);
+
+		return generation;
+	}
+
+	bool SharedDictionary::remove(std::string_view name)
+	{
+		std::string controlName(name);
+		int controlDescriptor = shm_open(controlName.data(), O_RDWR, 0);
+
+		if (controlDescriptor == -1)
+		{
+			return false;
+		}
+
+		flock(controlDescriptor, LOCK_EX);
+
+		if (void* control = mmap(nullptr, sizeof(Control), PROT_READ, MAP_SHARED, controlDescriptor, 0); control != MAP_FAILED)
+		{
+			shm_unlink(getSegmentName(name, getControl(control)->generation.load(std::memory_order_acquire)).data());
+
+			munmap(control, sizeof(Control));
+		}
+
+		shm_unlink(controlName.data());
+
+		close(controlDescriptor);
+
+		return true;
+	}
+
+	SharedDictionary::SharedDictionary(std::string_view name) :
+		name(name),
+		control(nullptr),
+		mapping()
+	{
+		int descriptor = shm_open(this->name.data(), O_RDONLY, 0);
+
+		if (descriptor == -1)
+		{
+			throw std::runtime_error(std::format("Can't open shared memory segment {}: {}", name, std::strerror(errno)));
+		}
+
+		struct stat status = {};
+		void* data = MAP_FAILED;
+
+		if (fstat(descriptor, &status) != -1 && status.st_size >= static_cast<off_t>(sizeof(Control)))
+		{
+			data = mmap(nullptr, sizeof(Control), PROT_READ, MAP_SHARED, descriptor, 0);
+		}
+
+		close(descriptor);
+
+		if (data == MAP_FAILED)
+		{
+			throw std::runtime_error(std::format("Can't map shared memory segment {}", name));
+		}
+
+		control = data;
+
+		try
+		{
+			if (getControl(control)->magic != controlMagic)
+			{
+				throw std::runtime_error(std::format("Shared memory segment {} has wrong format", name));
+			}
+
+			this->mapPublished();
+		}
+		catch (...)
+		{
+			munmap(data, sizeof(Control));
+
+			throw;
+		}
+	}
+
+	bool SharedDictionary::refresh()
+	{
+		if (this->getPublishedGeneration() == image.getGeneration())
+		{
+			return false;
+		}
+
+		this->mapPublished();
+
+		return true;
+	}
+
+	size_t SharedDictionary::releasePrevious()
+	{
+		size_t result = 0;
+
+		for (const Mapping& previous : previousMappings)
+		{
+			munmap(const_cast<void*>(previous.data), previous.size);
+
+			result += previous.size;
+		}
+
+		previousMappings.clear();
+
+		return result;
+	}
+
+	size_t SharedDictionary::getMemoryUsage() const
+	{
+		size_t result = mapping.size;
+
+		for (const Mapping& previous : previousMappings)
+		{
+			result += previous.size;
+		}
+
+		return result;
+	}
+
+	uint64_t SharedDictionary::getGeneration() const
+	{
+		return image.getGeneration();
+	}
+
+	uint64_t SharedDictionary::getPublishedGeneration() const
+	{
+		return getControl(control)->generation.load(std::memory_order_acquire);
+	}
+
+	const DictionaryImage& SharedDictionary::getImage() const
+	{
+		return image;
+	}
+
+	std::string_view SharedDictionary::getString(std::string_view key, std::string_view language, bool allowOriginal) const
+	{
+		return image.getString(key, language.empty() ? image.getOriginalLanguage() : language, allowOriginal);
+	}
+
+	SharedDictionary::~SharedDictionary()
+	{
+		this->unmap();
+
+		munmap(const_cast<void*>(control), sizeof(Control));
+	}
+}
+
+#endif
@@ -11,4 +11,85 @@ namespace localization::utility
 	{
 		return left == right;
 	}
+
+	size_t foldSymbol(std::string_view value, size_t index, char* result)
+	{
+		uint8_t lead = static_cast<uint8_t>(value[index]);
+
+		if (lead >= 'A' && lead <= 'Z')
+		{
+			result[0] = static_cast<char>(lead + ('a' - 'A'));
+
+			return 1;
+		}
+
+		if (index + 1 == value.size() || (lead != 0xC3 && lead != 0xCE && lead != 0xD0))
+		{
+			result[0] = static_cast<char>(lead);
+
+			return 1;
+		}
+
+		uint8_t next = static_cast<uint8_t>(value[index + 1]);
+
+		// Only letters which lower case has the same UTF-8 size
+		switch (lead)
+		{
+		case 0xC3: // U+00C0 - U+00DE except U+00D7
+			if (next >= 0x80 && next <= 0x9E && next != 0x97)
+			{
+				next += 0x20;
+			}
+
+			break;
+
+		case 0xCE: // U+0391 - U+03A9
+			if (next >= 0x91 && next <= 0x9F)
+			{
+				next += 0x20;
+			}
+			else if (next >= 0xA0 && next <= 0xA9 && next != 0xA2)
+			{
+				lead = 0xCF;
+				next -= 0x20;
+			}
+
+			break;
+
+		case 0xD0: // U+0400 - U+042F
+			if (next >= 0x80 && next <= 0x8F)
+			{
+				lead = 0xD1;
+				next += 0x10;
+			}
+			else if (next >= 0x90 && next <= 0x9F)
+			{
+				next += 0x20;
+			}
+			else if (next >= 0xA0 && next <= 0xAF)
+			{
+				lead = 0xD1;
+				next -= 0x20;
+			}
+
+			break;
+		}
+
+		result[0] = static_cast<char>(lead);
+		result[1] = static_cast<char>(next);
+
+		return 2;
+	}
+
+	std::string foldCase(std::string_view value)
+	{
+		std::string result(value);
+
+		for (size_t i = 0; i < value.size();)
+		{
+			i += foldSymbol(value, i, result.data() + i);
+		}
+
+		return result;
+	}
 }
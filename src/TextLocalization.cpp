@@ -0,0 +1,290 @@
+#include "TextLocalization.h"
+
+#include <stdexcept>
+#include <format>
+#include <fstream>
+
+#ifdef __LINUX__
+#include <dlfcn.h>
+#else
+#include <Windows.h>
+#endif
+
+#include <JsonParser.h>
+
+namespace localization
+{
+	template<typename T>
+	std::atomic<BaseTextLocalization<T>*> BaseTextLocalization<T>::instance = nullptr;
+
+	template<typename T>
+	void* BaseTextLocalization<T>::loadFunction(const char* name) const
+	{
+#ifdef __LINUX__
+		return dlsym(handle, name);
+#else
+		return reinterpret_cast<void*>(GetProcAddress(static_cast<HMODULE>(handle), name));
+#endif
+	}
+
+	template<typename T>
+	void BaseTextLocalization<T>::loadLocaleData()
+	{
+		for (const std::string& language : this->getLanguages())
+		{
+			LocaleData& data = localeData.try_emplace(language, language).first->second;
+
+			for (std::string_view key : locale::keys)
+			{
+				// Untranslated keys are empty and keep defaults of language
+				if (const char* value = dictionaries(key.data(), language.data()); value && *value)
+				{
+					data.setValue(key, value);
+				}
+			}
+		}
+	}
+
+	template<typename T>
+	BaseTextLocalization<T>::BaseTextLocalization(std::string_view localizationModule)
+	{
+		// Like dlopen, value with directory is path to module file and is loaded as is
+		if (std::filesystem::path pathToFile(localizationModule); pathToFile.has_parent_path())
+		{
+			pathToModule = std::filesystem::absolute(pathToFile);
+		}
+		else
+		{
+#ifdef __LINUX__
+			pathToModule = std::format("lib{}.so", localizationModule);
+#else
+			pathToModule = std::format("{}.dll", localizationModule);
+#endif
+		}
+
+		if (!std::filesystem::exists(pathToModule))
+		{
+			throw std::runtime_error(std::format("Can't find {}", pathToModule.string()));
+		}
+
+#ifdef __LINUX__
+		handle = dlopen(pathToModule.string().data(), RTLD_LAZY);
+#else
+		handle = LoadLibraryA(pathToModule.string().data());
+#endif
+		auto load = [this](const char* name)
+			{
+#ifdef __LINUX__
+				return dlsym(handle, name);
+#else
+				return GetProcAddress(static_cast<HMODULE>(handle), name);
+#endif
+			};
+
+		if (!handle)
+		{
+			throw std::runtime_error(std::format("Can't load {}", pathToModule.string()));
+		}
+
+		dictionaries = reinterpret_cast<DictionariesFunction>(load("getLocalizedString"));
+
+		if (!dictionaries)
+		{
+			throw std::runtime_error(std::format("Can't find getLocalizedString function in {}, rebuild and try again", pathToModule.string()));
+		}
+
+		originalLanguage = reinterpret_cast<OriginalLanguageFunction>(load("getOriginalLanguage"));
+
+		if (!originalLanguage)
+		{
+			throw std::runtime_error(std::format("Can't find getOriginalLanguage function in {}, rebuild and try again", pathToModule.string()));
+		}
+
+		findLanguage = reinterpret_cast<FindLanguageFunction>(load("findLanguage"));
+
+		if (!findLanguage)
+		{
+			throw std::runtime_error(std::format("Can't find findLanguage function in {}, rebuild and try again", pathToModule.string()));
+		}
+
+		language = originalLanguage();
+
+		this->loadLocaleData();
+	}
+
+	template<typename T>
+	BaseTextLocalization<T>::BaseTextLocalization(BaseTextLocalization<T>&& other) noexcept
+	{
+		(*this) = std::move(other);
+	}
+
+	template<typename T>
+	BaseTextLocalization<T>& BaseTextLocalization<T>::operator = (BaseTextLocalization<T>&& other) noexcept
+	{
+		dictionaries = other.dictionaries;
+		findLanguage = other.findLanguage;
+		originalLanguage = other.originalLanguage;
+		language = std::move(other.language);
+		pathToModule = std::move(other.pathToModule);
+		localeData = std::move(other.localeData);
+		handle = other.handle;
+
+		other.handle = nullptr;
+
+		return *this;
+	}
+
+	template<typename T>
+	BaseTextLocalization<T>::~BaseTextLocalization()
+	{
+		if (!handle)
+		{
+			return;
+		}
+
+#ifdef __LINUX__
+		dlclose(handle);
+#else
+		FreeLibrary(static_cast<HMODULE>(handle));
+#endif
+
+		handle = nullptr;
+	}
+
+	template<typename T>
+	BaseTextLocalization<T>& BaseTextLocalization<T>::initialize()
+	{
+		// Static local initialization is thread safe and repeated after exception
+		static std::unique_ptr<BaseTextLocalization<T>> storage = []()
+			{
+				json::JsonParser settings(std::ifstream(localizationModulesFile.data()));
+				std::unique_ptr<BaseTextLocalization<T>> result(new BaseTextLocalization<T>(settings.get<std::string>(settings::defaultModuleSetting)));
+
+				instance.store(result.get(), std::memory_order_release);
+
+				return result;
+			}();
+
+		return *storage;
+	}
+
+	template<typename T>
+	void BaseTextLocalization<T>::changeLanguage(std::string_view language)
+	{
+		if (!findLanguage(language.data()))
+		{
+			throw std::runtime_error(std::format(R"(Wrong language value "{}")", language));
+		}
+
+		this->language = language;
+	}
+
+	template<typename T>
+	std::string_view BaseTextLocalization<T>::getOriginalLanguage() const
+	{
+		return originalLanguage();
+	}
+
+	template<typename T>
+	std::string_view BaseTextLocalization<T>::getCurrentLanguage() const
+	{
+		return language;
+	}
+
+	template<typename T>
+	const std::filesystem::path& BaseTextLocalization<T>::getPathToModule() const
+	{
+		return pathToModule;
+	}
+
+	template<typename T>
+	std::vector<std::string> BaseTextLocalization<T>::getLanguages() const
+	{
+		DictionariesLanguagesFunction dictionariesLanguagesFunction = reinterpret_cast<DictionariesLanguagesFunction>(this->loadFunction("getDictionariesLanguages"));
+		FreeDictionariesLanguagesFunction freeDictionariesLanguagesFunction = reinterpret_cast<FreeDictionariesLanguagesFunction>(this->loadFunction("freeDictionariesLanguages"));
+
+		if (!dictionariesLanguagesFunction || !freeDictionariesLanguagesFunction)
+		{
+			throw std::runtime_error(std::format("Can't find getDictionariesLanguages function in {}, rebuild and try again", pathToModule.string()));
+		}
+
+		uint64_t size = 0;
+		const char** languages = dictionariesLanguagesFunction(&size);
+		std::vector<std::string> result(languages, languages + size);
+
+		freeDictionariesLanguagesFunction(languages);
+
+		return result;
+	}
+
+	template<typename T>
+	const LocaleData& BaseTextLocalization<T>::getLocaleData(std::string_view language) const
+	{
+		auto it = localeData.find(language);
+
+		if (it == localeData.end())
+		{
+			throw std::runtime_error(std::format(R"(Wrong language value "{}")", language));
+		}
+
+		return it->second;
+	}
+
+	template<typename T>
+	const LocaleData& BaseTextLocalization<T>::getLocaleData() const
+	{
+		return this->getLocaleData(language);
+	}
+
+	template<typename T>
+	const char* BaseTextLocalization<T>::find(std::string_view key, std::string_view language) const noexcept
+	{
+		return dictionaries(key.data(), language.data());
+	}
+
+	template<typename T>
+	std::basic_string_view<T> BaseTextLocalization<T>::getString(std::string_view key, std::string_view language, bool allowOriginal) const
+	{
+		const char* result = dictionaries(key.data(), language.data());
+
+		// Untranslated values are empty
+		if (!result || (!*result && allowOriginal))
+		{
+			if (!allowOriginal)
+			{
+				throw std::runtime_error(std::format(R"(Can't find key "{}" for {})", key, language));
+			}
+
+			std::string_view originalLanguageView = this->getOriginalLanguage();
+
+			result = dictionaries(key.data(), originalLanguageView.data());
+
+			if (!result)
+			{
+				throw std::runtime_error(std::format(R"(Can't find key "{}" for {}, also can't find in original language {})", key, language, originalLanguageView));
+			}
+		}
+
+		return std::string_view(result);
+	}
+
+	template<typename T>
+	std::basic_string_view<T> BaseTextLocalization<T>::operator [] (std::string_view key) const
+	{
+		return this->getString(key, language);
+	}
+
+	template<typename T>
+	void BaseTextLocalization<T>::loadDictionaryFunctions(DictionaryFunction& dictionaryFunction, FreeDictionaryFunction& freeDictionaryFunction) const
+	{
+		dictionaryFunction = reinterpret_cast<DictionaryFunction>(this->loadFunction("getDictionary"));
+		freeDictionaryFunction = reinterpret_cast<FreeDictionaryFunction>(this->loadFunction("freeDictionary"));
+
+		if (!dictionaryFunction || !freeDictionaryFunction)
+		{
+			throw std::runtime_error(std::format("Can't find getDictionary function in {}, rebuild and try again", pathToModule.string()));
+		}
+	}
+
+	template class BaseTextLocalization<char>;
+}
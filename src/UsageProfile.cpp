@@ -0,0 +1,211 @@
+#include "UsageProfile.h"
+
+#include <fstream>
+#include <format>
+
+namespace localization
+{
+	bool UsageProfile::Module::hasLanguage(std::string_view language) const
+	{
+		return languages.contains(language) || keys.contains(language);
+	}
+
+	bool UsageProfile::Module::isKeyAllowed(std::string_view language, std::string_view key) const
+	{
+		if (languages.contains(language))
+		{
+			return true;
+		}
+
+		auto it = keys.find(language);
+
+		return it != keys.end() && it->second.contains(key);
+	}
+
+	bool UsageProfile::Module::isKeyUsed(std::string_view key) const
+	{
+		if (languages.size())
+		{
+			return true;
+		}
+
+		for (const auto& [_, languageKeys] : keys)
+		{
+			if (languageKeys.contains(key))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	UsageProfile UsageProfile::load(const std::filesystem::path& pathToProfile)
+	{
+		std::ifstream input(pathToProfile);
+
+		if (!input.is_open())
+		{
+			throw std::runtime_error(std::format("Can't open usage profile {}", pathToProfile.string()));
+		}
+
+		UsageProfile result;
+		std::string line;
+
+		for (size_t lineNumber = 1; std::getline(input, line); lineNumber++)
+		{
+			if (line.size() && line.back() == '\r')
+			{
+				line.pop_back();
+			}
+
+			if (line.empty() || line.front() == '#')
+			{
+				continue;
+			}
+
+			size_t languageStart = line.find('\t');
+
+			if (languageStart == std::string::npos || !languageStart)
+			{
+				throw std::runtime_error(std::format("Wrong usage profile line {} in {}, expected \"module<tab>language[<tab>key]\"", lineNumber, pathToProfile.string()));
+			}
+
+			std::string_view entry(line);
+			std::string_view module = entry.substr(0, languageStart);
+			size_t keyStart = entry.find('\t', languageStart + 1);
+			std::string_view language = entry.substr(languageStart + 1, keyStart == std::string::npos ? std::string::npos : keyStart - languageStart - 1);
+
+			if (language.empty())
+			{
+				throw std::runtime_error(std::format("Empty language in usage profile line {} in {}", lineNumber, pathToProfile.string()));
+			}
+
+			if (keyStart == std::string::npos)
+			{
+				result.addLanguage(module, language);
+			}
+			else
+			{
+				result.addKey(module, language, entry.substr(keyStart + 1));
+			}
+		}
+
+		return result;
+	}
+
+	void UsageProfile::save(const std::filesystem::path& pathToProfile) const
+	{
+		std::ofstream output(pathToProfile, std::ios::binary);
+
+		if (!output.is_open())
+		{
+			throw std::runtime_error(std::format("Can't open usage profile {}", pathToProfile.string()));
+		}
+
+		for (const auto& [name, module] : modules)
+		{
+			for (const std::string& language : module.languages)
+			{
+				output << name << '\t' << language << '\n';
+			}
+
+			for (const auto& [language, keys] : module.keys)
+			{
+				for (const std::string& key : keys)
+				{
+					output << name << '\t' << language << '\t' << key << '\n';
+				}
+			}
+		}
+	}
+
+	void UsageProfile::addLanguage(std::string_view module, std::string_view language)
+	{
+		auto it = modules.find(module);
+
+		if (it == modules.end())
+		{
+			it = modules.emplace(module, Module()).first;
+		}
+
+		it->second.languages.emplace(language);
+	}
+
+	void UsageProfile::addKey(std::string_view module, std::string_view language, std::string_view key)
+	{
+		auto moduleIterator = modules.find(module);
+
+		if (moduleIterator == modules.end())
+		{
+			moduleIterator = modules.emplace(module, Module()).first;
+		}
+
+		auto& keys = moduleIterator->second.keys;
+		auto languageIterator = keys.find(language);
+
+		if (languageIterator == keys.end())
+		{
+			languageIterator = keys.emplace(language, std::set<std::string, std::less<>>()).first;
+		}
+
+		languageIterator->second.emplace(key);
+	}
+
+	std::optional<UsageProfile::Module> UsageProfile::getModule(std::string_view module) const
+	{
+		auto moduleIterator = modules.find(module);
+		auto anyIterator = modules.find(anyModule);
+
+		if (moduleIterator == modules.end() && anyIterator == modules.end())
+		{
+			return std::nullopt;
+		}
+
+		Module result;
+
+		for (auto it : { moduleIterator, anyIterator })
+		{
+			if (it == modules.end())
+			{
+				continue;
+			}
+
+			result.languages.insert(it->second.languages.begin(), it->second.languages.end());
+
+			for (const auto& [language, keys] : it->second.keys)
+			{
+				result.keys[language].insert(keys.begin(), keys.end());
+			}
+		}
+
+		return result;
+	}
+
+	const std::map<std::string, UsageProfile::Module, std::less<>>& UsageProfile::getModules() const
+	{
+		return modules;
+	}
+
+	size_t UsageProfile::size() const
+	{
+		size_t result = 0;
+
+		for (const auto& [_, module] : modules)
+		{
+			result += module.languages.size();
+
+			for (const auto& [language, keys] : module.keys)
+			{
+				result += keys.size();
+			}
+		}
+
+		return result;
+	}
+
+	bool UsageProfile::empty() const
+	{
+		return modules.empty();
+	}
+}
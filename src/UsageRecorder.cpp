@@ -0,0 +1,76 @@
+#include "UsageRecorder.h"
+
+#include <bit>
+
+namespace
+{
+	/// @brief Image is built in temporary vector and copied with exact size
+	std::pmr::vector<std::byte> buildImage(const localization::TextLocalization& localization, std::pmr::memory_resource* resource)
+	{
+		std::vector<std::byte> image = localization::DictionaryImage::build(localization);
+
+		return std::pmr::vector<std::byte>(image.begin(), image.end(), resource);
+	}
+}
+
+namespace localization
+{
+	UsageRecorder::UsageRecorder(const TextLocalization& localization, std::pmr::memory_resource* resource) :
+		image(buildImage(localization, resource)),
+		index(image.data()),
+		// Value initialized to zero
+		bits((index.getSlotsCount() + 63) / 64, resource)
+	{
+
+	}
+
+	bool UsageRecorder::record(std::string_view key, std::string_view language) noexcept
+	{
+		size_t slot = index.findSlot(key, language);
+
+		if (slot == DictionaryImage::npos)
+		{
+			return false;
+		}
+
+		std::atomic<uint64_t>& word = bits[slot / 64];
+		uint64_t mask = 1ULL << (slot % 64);
+
+		if (!(word.load(std::memory_order_relaxed) & mask))
+		{
+			word.fetch_or(mask, std::memory_order_relaxed);
+		}
+
+		return true;
+	}
+
+	std::string_view UsageRecorder::getOriginalLanguage() const
+	{
+		return index.getOriginalLanguage();
+	}
+
+	void UsageRecorder::collect(std::string_view module, UsageProfile& profile) const
+	{
+		for (size_t i = 0; i < bits.size(); i++)
+		{
+			for (uint64_t word = bits[i].load(std::memory_order_relaxed); word; word &= word - 1)
+			{
+				auto [language, key] = index.getSlot(i * 64 + std::countr_zero(word));
+
+				profile.addKey(module, language, key);
+			}
+		}
+	}
+
+	size_t UsageRecorder::getRecordedCount() const
+	{
+		size_t result = 0;
+
+		for (size_t i = 0; i < bits.size(); i++)
+		{
+			result += std::popcount(bits[i].load(std::memory_order_relaxed));
+		}
+
+		return result;
+	}
+}
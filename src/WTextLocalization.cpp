@@ -2,28 +2,56 @@
 
 #include "WTextLocalization.h"
 
-static std::wstring to_wstring(std::string_view source);
+#include <format>
+#include <fstream>
+#include <mutex>
+
+#include <Windows.h>
+
+#include <JsonParser.h>
+
+#include "UsageProfile.h"
+
+static std::pmr::wstring to_wstring(std::string_view source, std::pmr::memory_resource* resource);
 
 namespace localization
 {
-	void BaseTextLocalization<wchar_t>::convertLocalization(const TextLocalization& localizationModule)
+	struct BaseTextLocalization<wchar_t>::Converted
+	{
+		std::mutex mutex;
+		/// @brief Function of module, so source TextLocalization may be moved
+		TextLocalization::DictionariesFunction dictionaries;
+		Dictionaries values;
+
+		Converted(TextLocalization::DictionariesFunction dictionaries, std::pmr::memory_resource* resource) :
+			dictionaries(dictionaries),
+			values(resource)
+		{
+
+		}
+	};
+
+	std::atomic<WTextLocalization*> BaseTextLocalization<wchar_t>::instance = nullptr;
+
+	void BaseTextLocalization<wchar_t>::convertLocalization(const TextLocalization& localizationModule, const UsageProfile* usageProfile, std::string_view moduleName)
 	{
 		using getDictionariesLanguages = const char** (*)(uint64_t* size);
 		using getDictionary = const char* (*)(const char* language, uint64_t* size, const char*** key, const char*** values);
 		using freeDictionary = void(*)(const char** keys, const char** values);
 
-		auto load = [this](HMODULE handle, const char* name)
+		auto load = [this](void* handle, const char* name)
 			{
 #ifdef __LINUX__
 				return dlsym(handle, name);
 #else
-				return GetProcAddress(handle, name);
+				return GetProcAddress(static_cast<HMODULE>(handle), name);
 #endif
 			};
 
 		originalLanguage = localizationModule.getOriginalLanguage();
 		language = localizationModule.language;
 		pathToModule = localizationModule.getPathToModule();
+		localeData = localizationModule.localeData;
 
 		getDictionariesLanguages dictionariesLanguagesFunction = reinterpret_cast<getDictionariesLanguages>(load(localizationModule.handle, "getDictionariesLanguages"));
 		getDictionary dictionaryFunction = reinterpret_cast<getDictionary>(load(localizationModule.handle, "getDictionary"));
@@ -32,10 +60,29 @@ namespace localization
 		uint64_t languagesSize = 0;
 		const char** languages = dictionariesLanguagesFunction(&languagesSize);
 
+		std::pmr::memory_resource* resource = dictionaries.get_allocator().resource();
+		std::optional<UsageProfile::Module> module = usageProfile ? usageProfile->getModule(moduleName) : std::nullopt;
+		const UsageProfile::Module* usage = module ? &*module : nullptr;
+
+		if (usage)
+		{
+			converted = std::make_unique<Converted>(localizationModule.dictionaries, resource);
+		}
+
 		for (uint64_t i = 0; i < languagesSize; i++)
 		{
 			const char* language = languages[i];
-			std::unordered_map<std::string, std::wstring, utility::StringViewHash, utility::StringViewEqual> convertedDictionary;
+			bool isOriginal = originalLanguage == language;
+			Dictionary convertedDictionary(resource);
+
+			// Empty dictionary keeps language valid, its values are converted on first lookup
+			if (usage && !isOriginal && !usage->hasLanguage(language))
+			{
+				dictionaries.insert_or_assign(std::pmr::string(language, resource), std::move(convertedDictionary));
+
+				continue;
+			}
+
 			uint64_t dictionarySize = 0;
 			const char** keys;
 			const char** values;
@@ -46,10 +93,15 @@ namespace localization
 
 			for (uint64_t j = 0; j < dictionarySize; j++)
 			{
-				convertedDictionary[keys[j]] = to_wstring(values[j]);	
+				if (usage && !usage->isKeyAllowed(language, keys[j]) && !(isOriginal && usage->isKeyUsed(keys[j])))
+				{
+					continue;
+				}
+
+				convertedDictionary.insert_or_assign(std::pmr::string(keys[j], resource), to_wstring(values[j], resource));
 			}
 
-			dictionaries[language] = move(convertedDictionary);
+			dictionaries.insert_or_assign(std::pmr::string(language, resource), std::move(convertedDictionary));
 
 			freeDictionaryFunction(keys, values);
 		}
@@ -57,6 +109,49 @@ namespace localization
 		reinterpret_cast<void(*)(const char**)>(load(localizationModule.handle, "freeDictionariesLanguages"))(languages);
 	}
 
+	const std::pmr::wstring* BaseTextLocalization<wchar_t>::find(std::string_view key, std::string_view language) const
+	{
+		auto languageIterator = dictionaries.find(language);
+
+		if (languageIterator == dictionaries.end())
+		{
+			throw std::runtime_error(std::format("Can't find language: {}", language));
+		}
+
+		if (auto keyIterator = languageIterator->second.find(key); keyIterator != languageIterator->second.end())
+		{
+			return &keyIterator->second;
+		}
+
+		if (!converted)
+		{
+			return nullptr;
+		}
+
+		std::lock_guard<std::mutex> lock(converted->mutex);
+		std::pmr::memory_resource* resource = converted->values.get_allocator().resource();
+		auto convertedLanguageIterator = converted->values.find(language);
+
+		if (convertedLanguageIterator == converted->values.end())
+		{
+			convertedLanguageIterator = converted->values.try_emplace(std::pmr::string(language, resource)).first;
+		}
+		else if (auto keyIterator = convertedLanguageIterator->second.find(key); keyIterator != convertedLanguageIterator->second.end())
+		{
+			return &keyIterator->second;
+		}
+
+		const char* value = converted->dictionaries(key.data(), language.data());
+
+		if (!value)
+		{
+			return nullptr;
+		}
+
+		// Nodes don't move on rehash, so returned value stays valid
+		return &convertedLanguageIterator->second.try_emplace(std::pmr::string(key, resource), to_wstring(value, resource)).first->second;
+	}
+
 	BaseTextLocalization<wchar_t>::BaseTextLocalization(std::string_view localizationModule) :
 		handle(nullptr)
 	{
@@ -70,39 +165,57 @@ namespace localization
 		}
 	}
 
-	BaseTextLocalization<wchar_t>::BaseTextLocalization(const TextLocalization& localizationModule) :
+	BaseTextLocalization<wchar_t>::BaseTextLocalization(const TextLocalization& localizationModule, std::pmr::memory_resource* resource, const UsageProfile* usage, std::string_view moduleName) :
+		dictionaries(resource),
 		handle(nullptr)
 	{
-		this->convertLocalization(localizationModule);
+		this->convertLocalization(localizationModule, usage, moduleName);
 	}
 
-	BaseTextLocalization<wchar_t>::BaseTextLocalization(WTextLocalization&& other) noexcept
+	BaseTextLocalization<wchar_t>::BaseTextLocalization(WTextLocalization&& other) noexcept :
+		// Move construction keeps memory resource of other dictionaries, move assignment copies if resources differ
+		dictionaries(std::move(other.dictionaries)),
+		originalLanguage(std::move(other.originalLanguage)),
+		language(std::move(other.language)),
+		pathToModule(std::move(other.pathToModule)),
+		localeData(std::move(other.localeData)),
+		converted(std::move(other.converted)),
+		handle(nullptr)
 	{
-		(*this) = std::move(other);
+
 	}
 
 	WTextLocalization& BaseTextLocalization<wchar_t>::operator = (WTextLocalization&& other) noexcept
 	{
-		dictionaries = std::move(other.dictionaries);
+		// Construct again instead of move assignment, which copies into previous memory resource if resources differ
+		std::destroy_at(&dictionaries);
+		std::construct_at(&dictionaries, std::move(other.dictionaries));
+
 		originalLanguage = std::move(other.originalLanguage);
 		language = std::move(other.language);
 		pathToModule = std::move(other.pathToModule);
+		localeData = std::move(other.localeData);
+		converted = std::move(other.converted);
 
 		return *this;
 	}
 
-	BaseTextLocalization<wchar_t>& BaseTextLocalization<wchar_t>::get()
+	BaseTextLocalization<wchar_t>::~BaseTextLocalization() = default;
+
+	BaseTextLocalization<wchar_t>& BaseTextLocalization<wchar_t>::initialize()
 	{
-		static std::unique_ptr<BaseTextLocalization<wchar_t>> instance;
+		// Static local initialization is thread safe and repeated after exception
+		static std::unique_ptr<WTextLocalization> storage = []()
+			{
+				json::JsonParser settings(std::ifstream(localizationModulesFile.data()));
+				std::unique_ptr<WTextLocalization> result(new WTextLocalization(settings.get<std::string>(settings::defaultModuleSetting)));
 
-		if (!instance)
-		{
-			json::JsonParser settings(std::ifstream(localizationModulesFile.data()));
+				instance.store(result.get(), std::memory_order_release);
 
-			instance = std::unique_ptr<WTextLocalization>(new WTextLocalization(settings.get<std::string>(settings::defaultModuleSetting)));
-		}
+				return result;
+			}();
 
-		return *instance;
+		return *storage;
 	}
 
 	void BaseTextLocalization<wchar_t>::changeLanguage(std::string_view language)
@@ -130,39 +243,36 @@ namespace localization
 		return pathToModule;
 	}
 
-	std::wstring_view BaseTextLocalization<wchar_t>::getString(std::string_view key, std::string_view language, bool allowOriginal) const
+	const LocaleData& BaseTextLocalization<wchar_t>::getLocaleData(std::string_view language) const
 	{
-		if (auto languageIterator = dictionaries.find(language); languageIterator != dictionaries.end())
+		auto it = localeData.find(language);
+
+		if (it == localeData.end())
 		{
-			if (auto keyIterator = languageIterator->second.find(key); keyIterator != languageIterator->second.end())
-			{
-				if (keyIterator->second.size())
-				{
-					return keyIterator->second;
-				}
+			throw std::runtime_error(std::format(R"(Wrong language value "{}")", language));
+		}
 
-				if (allowOriginal)
-				{
-					return this->getString(key, originalLanguage, false);
-				}
-				
-				throw std::runtime_error(std::format("Can't find localized string with key: {}", key));
-			}
-			else if (allowOriginal)
-			{
-				return this->getString(key, originalLanguage, false);
-			}
-			else
-			{
-				throw std::runtime_error(std::format("Can't find localized string with key: {}", key));
-			}
+		return it->second;
+	}
+
+	const LocaleData& BaseTextLocalization<wchar_t>::getLocaleData() const
+	{
+		return this->getLocaleData(language);
+	}
+
+	std::wstring_view BaseTextLocalization<wchar_t>::getString(std::string_view key, std::string_view language, bool allowOriginal) const
+	{
+		if (const std::pmr::wstring* value = this->find(key, language); value && value->size())
+		{
+			return *value;
 		}
-		else
+
+		if (allowOriginal)
 		{
-			throw std::runtime_error(std::format("Can't find language: {}", language));
+			return this->getString(key, originalLanguage, false);
 		}
 
-		return {};
+		throw std::runtime_error(std::format("Can't find localized string with key: {}", key));
 	}
 
 	std::wstring_view BaseTextLocalization<wchar_t>::operator [](std::string_view key) const
@@ -171,9 +281,9 @@ namespace localization
 	}
 }
 
-std::wstring to_wstring(std::string_view stringToConvert)
+std::pmr::wstring to_wstring(std::string_view stringToConvert, std::pmr::memory_resource* resource)
 {
-	std::wstring result;
+	std::pmr::wstring result(resource);
 
 	int size = MultiByteToWideChar
 	(		
@@ -0,0 +1,390 @@
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <unordered_set>
+#include <format>
+
+#ifdef __LINUX__
+#include <dlfcn.h>
+#else
+#include <Windows.h>
+#endif
+
+#include <JsonParser.h>
+#include <JsonArrayWrapper.h>
+
+#include "MultiLocalizationManager.h"
+#include "DictionaryImage.h"
+
+struct LanguageReport
+{
+	std::string language;
+	size_t keys = 0;
+	size_t keyBytes = 0;
+	size_t valueBytes = 0;
+	size_t emptyKeys = 0;
+	size_t missingKeys = 0;
+	localization::DictionaryImage::ProbeStatistics image = {};
+	size_t buckets = 0;
+	size_t emptyBuckets = 0;
+	size_t maxBucketSize = 0;
+	double loadFactor = 0.0;
+};
+
+struct ModuleReport
+{
+	std::string name;
+	std::string path;
+	std::string originalLanguage;
+	double loadMilliseconds = 0.0;
+	double resolveMilliseconds = 0.0;
+	double sweepMilliseconds = 0.0;
+	double imageBuildMilliseconds = 0.0;
+	size_t imageBytes = 0;
+	std::vector<LanguageReport> languages;
+};
+
+using DictionariesLanguagesFunction = const char** (*)(uint64_t* size);
+using FreeDictionariesLanguagesFunction = void (*)(const char** languages);
+using DictionaryFunction = const char* (*)(const char* language, uint64_t* size, const char*** keys, const char*** values);
+using FreeDictionaryFunction = void (*)(const char** keys, const char** values);
+using OriginalLanguageFunction = const char* (*)();
+
+static double elapsedMilliseconds(std::chrono::steady_clock::time_point start);
+
+static std::string escape(std::string_view value);
+
+/// @brief Load module directly to measure dlopen, symbols resolve and dictionaries sweep
+/// @param name Module name or absolute path to module file
+static ModuleReport inspectModule(const std::string& name);
+
+static void inspectImage(const localization::TextLocalization& localization, ModuleReport& report);
+
+static void printReport(const std::vector<ModuleReport>& reports);
+
+/// @brief Arguments: [settings file with .json extension, localization_modules.json by default] [module name or path to module file]...
+int main(int argc, char** argv)
+{
+	std::filesystem::path pathToSettings = localization::localizationModulesFile;
+	std::vector<std::string> modules;
+
+	for (int i = 1; i < argc; i++)
+	{
+		std::filesystem::path argument = argv[i];
+
+		if (argument.extension() == ".json")
+		{
+			pathToSettings = std::filesystem::absolute(argument);
+		}
+		else
+		{
+			// Paths must be resolved before changing current directory
+			modules.push_back(argument.has_parent_path() ? std::filesystem::absolute(argument).string() : argument.string());
+		}
+	}
+
+	try
+	{
+		std::ifstream settingsFile(pathToSettings);
+
+		if (!settingsFile.is_open())
+		{
+			throw std::runtime_error(std::format("Can't open {}", pathToSettings.string()));
+		}
+
+		json::JsonParser settings(std::move(settingsFile));
+
+		// Module names are relative to settings file
+		if (pathToSettings.has_parent_path())
+		{
+			std::filesystem::current_path(pathToSettings.parent_path());
+		}
+
+		std::string defaultModule = settings.get<std::string>(localization::settings::defaultModuleSetting);
+		std::vector<std::string> settingsModules = json::utility::JsonArrayWrapper(settings.get<std::vector<json::JsonObject>>(localization::settings::modulesSetting)).as<std::string>();
+		std::vector<ModuleReport> reports;
+
+		modules.insert(modules.begin(), settingsModules.begin(), settingsModules.end());
+		modules.insert(modules.begin(), defaultModule);
+
+		// Measure cold load before MultiLocalizationManager loads modules
+		for (const std::string& module : modules)
+		{
+			reports.push_back(inspectModule(module));
+		}
+
+#ifdef __LINUX__
+		// Settings file may have other name, modules are loaded as listed in it
+		localization::MultiLocalizationManager& manager = localization::MultiLocalizationManager::getSharedManager();
+#else
+		localization::MultiLocalizationManager& manager = localization::MultiLocalizationManager::getManager();
+#endif
+
+		for (ModuleReport& report : reports)
+		{
+			if (report.name == manager.getDefaultModuleName())
+			{
+				inspectImage(localization::TextLocalization::get(), report);
+			}
+			else
+			{
+				localization::MultiLocalizationManager::LocalizationHolder* holder = nullptr;
+
+				try
+				{
+					holder = manager.getModule(report.name);
+				}
+				catch (const std::runtime_error&)
+				{
+					holder = manager.addModule(report.name);
+				}
+
+				inspectImage(holder->localization, report);
+			}
+		}
+
+		printReport(reports);
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << e.what() << std::endl;
+
+		return 1;
+	}
+
+	return 0;
+}
+
+double elapsedMilliseconds(std::chrono::steady_clock::time_point start)
+{
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+std::string escape(std::string_view value)
+{
+	std::string result;
+
+	for (char symbol : value)
+	{
+		switch (symbol)
+		{
+		case '"':
+			result += "\\\"";
+
+			break;
+
+		case '\\':
+			result += "\\\\";
+
+			break;
+
+		default:
+			if (static_cast<unsigned char>(symbol) < 0x20)
+			{
+				result += std::format("\\u{:04x}", static_cast<int>(symbol));
+			}
+			else
+			{
+				result += symbol;
+			}
+		}
+	}
+
+	return result;
+}
+
+ModuleReport inspectModule(const std::string& name)
+{
+	ModuleReport report;
+
+	report.name = name;
+
+	if (std::filesystem::path(name).has_parent_path())
+	{
+		report.path = name;
+	}
+	else
+	{
+#ifdef __LINUX__
+		report.path = std::format("lib{}.so", name);
+#else
+		report.path = std::format("{}.dll", name);
+#endif
+	}
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+#ifdef __LINUX__
+	void* handle = dlopen(report.path.data(), RTLD_LAZY);
+#else
+	HMODULE handle = LoadLibraryA(report.path.data());
+#endif
+
+	report.loadMilliseconds = elapsedMilliseconds(start);
+
+	if (!handle)
+	{
+		throw std::runtime_error(std::format("Can't load {}", report.path));
+	}
+
+	auto load = [handle](const char* name)
+		{
+#ifdef __LINUX__
+			return reinterpret_cast<void*>(dlsym(handle, name));
+#else
+			return reinterpret_cast<void*>(GetProcAddress(handle, name));
+#endif
+		};
+
+	start = std::chrono::steady_clock::now();
+
+	void* localizedStringFunction = load("getLocalizedString");
+	void* findLanguageFunction = load("findLanguage");
+	OriginalLanguageFunction originalLanguage = reinterpret_cast<OriginalLanguageFunction>(load("getOriginalLanguage"));
+	DictionariesLanguagesFunction dictionariesLanguages = reinterpret_cast<DictionariesLanguagesFunction>(load("getDictionariesLanguages"));
+	FreeDictionariesLanguagesFunction freeDictionariesLanguages = reinterpret_cast<FreeDictionariesLanguagesFunction>(load("freeDictionariesLanguages"));
+	DictionaryFunction dictionary = reinterpret_cast<DictionaryFunction>(load("getDictionary"));
+	FreeDictionaryFunction freeDictionary = reinterpret_cast<FreeDictionaryFunction>(load("freeDictionary"));
+
+	report.resolveMilliseconds = elapsedMilliseconds(start);
+
+	if (!localizedStringFunction || !findLanguageFunction || !originalLanguage || !dictionariesLanguages || !freeDictionariesLanguages || !dictionary || !freeDictionary)
+	{
+		throw std::runtime_error(std::format("Can't find localization functions in {}, rebuild and try again", report.path));
+	}
+
+	report.originalLanguage = originalLanguage();
+
+	uint64_t languagesSize = 0;
+	const char** languages = dictionariesLanguages(&languagesSize);
+	std::unordered_set<std::string> originalKeys;
+	std::vector<std::unordered_set<std::string>> languageKeys(languagesSize);
+
+	start = std::chrono::steady_clock::now();
+
+	for (uint64_t i = 0; i < languagesSize; i++)
+	{
+		LanguageReport& languageReport = report.languages.emplace_back();
+		uint64_t size = 0;
+		const char** keys = nullptr;
+		const char** values = nullptr;
+
+		languageReport.language = languages[i];
+
+		dictionary(languages[i], &size, &keys, &values);
+
+		languageReport.keys = size;
+
+		for (uint64_t j = 0; j < size; j++)
+		{
+			size_t valueSize = std::char_traits<char>::length(values[j]);
+
+			languageReport.keyBytes += std::char_traits<char>::length(keys[j]);
+			languageReport.valueBytes += valueSize;
+			languageReport.emptyKeys += !valueSize;
+
+			languageKeys[i].emplace(keys[j]);
+		}
+
+		freeDictionary(keys, values);
+	}
+
+	report.sweepMilliseconds = elapsedMilliseconds(start);
+
+	freeDictionariesLanguages(languages);
+
+	for (size_t i = 0; i < report.languages.size(); i++)
+	{
+		if (report.languages[i].language == report.originalLanguage)
+		{
+			originalKeys = languageKeys[i];
+		}
+	}
+
+	for (size_t i = 0; i < report.languages.size(); i++)
+	{
+		for (const std::string& key : originalKeys)
+		{
+			report.languages[i].missingKeys += !languageKeys[i].contains(key);
+		}
+	}
+
+#ifdef __LINUX__
+	dlclose(handle);
+#else
+	FreeLibrary(handle);
+#endif
+
+	return report;
+}
+
+void inspectImage(const localization::TextLocalization& localization, ModuleReport& report)
+{
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	std::vector<std::byte> data = localization::DictionaryImage::build(localization);
+
+	report.imageBuildMilliseconds = elapsedMilliseconds(start);
+	report.imageBytes = data.size();
+
+	localization::DictionaryImage image(data.data());
+
+	for (LanguageReport& languageReport : report.languages)
+	{
+		std::unordered_map<std::string_view, std::string_view, localization::utility::StringViewHash, localization::utility::StringViewEqual> table;
+
+		languageReport.image = image.getProbeStatistics(languageReport.language);
+
+		// Same layout as WTextLocalization and OverlayTable dictionaries
+		localization.forEachString
+		(
+			languageReport.language,
+			[&table](std::string_view key, std::string_view value)
+			{
+				table.try_emplace(key, value);
+			}
+		);
+
+		languageReport.buckets = table.bucket_count();
+		languageReport.loadFactor = table.load_factor();
+
+		for (size_t bucket = 0; bucket < table.bucket_count(); bucket++)
+		{
+			size_t size = table.bucket_size(bucket);
+
+			languageReport.emptyBuckets += !size;
+			languageReport.maxBucketSize = std::max(languageReport.maxBucketSize, size);
+		}
+	}
+}
+
+void printReport(const std::vector<ModuleReport>& reports)
+{
+	std::cout << "{\n  \"version\": \"" << localization::MultiLocalizationManager::getVersion() << "\",\n  \"modules\": [";
+
+	for (size_t i = 0; i < reports.size(); i++)
+	{
+		const ModuleReport& report = reports[i];
+
+		std::cout << (i ? "," : "") << "\n    {\n";
+		std::cout << std::format("      \"name\": \"{}\",\n      \"path\": \"{}\",\n      \"originalLanguage\": \"{}\",\n", escape(report.name), escape(report.path), escape(report.originalLanguage));
+		std::cout << std::format("      \"loadMs\": {:.3f},\n      \"resolveMs\": {:.3f},\n      \"sweepMs\": {:.3f},\n      \"imageBuildMs\": {:.3f},\n      \"imageBytes\": {},\n", report.loadMilliseconds, report.resolveMilliseconds, report.sweepMilliseconds, report.imageBuildMilliseconds, report.imageBytes);
+		std::cout << "      \"languages\": [";
+
+		for (size_t j = 0; j < report.languages.size(); j++)
+		{
+			const LanguageReport& language = report.languages[j];
+
+			std::cout << (j ? "," : "") << "\n        {\n";
+			std::cout << std::format("          \"language\": \"{}\",\n          \"keys\": {},\n          \"keyBytes\": {},\n          \"valueBytes\": {},\n          \"emptyKeys\": {},\n          \"missingKeys\": {},\n", escape(language.language), language.keys, language.keyBytes, language.valueBytes, language.emptyKeys, language.missingKeys);
+			std::cout << std::format("          \"image\": {{ \"capacity\": {}, \"averageProbeLength\": {:.3f}, \"maxProbeLength\": {}, \"collisions\": {} }},\n", language.image.capacity, language.image.averageProbeLength, language.image.maxProbeLength, language.image.collisions);
+			std::cout << std::format("          \"unorderedMap\": {{ \"buckets\": {}, \"loadFactor\": {:.3f}, \"emptyBuckets\": {}, \"maxBucketSize\": {} }}\n", language.buckets, language.loadFactor, language.emptyBuckets, language.maxBucketSize);
+			std::cout << "        }";
+		}
+
+		std::cout << "\n      ]\n    }";
+	}
+
+	std::cout << "\n  ]\n}" << std::endl;
+}
@@ -0,0 +1,172 @@
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <chrono>
+#include <format>
+#include <cstring>
+
+#include "MultiLocalizationManager.h"
+#include "LookupTracer.h"
+
+struct ReplayStatistics
+{
+	std::vector<uint64_t> latencies;
+	uint64_t misses = 0;
+	uint64_t mismatches = 0;
+};
+
+static void printUsage();
+
+static void replay(const localization::LookupTrace& trace, const std::vector<const localization::TraceRecord*>& records, bool originalSpeed, std::chrono::steady_clock::time_point start, ReplayStatistics& statistics);
+
+int main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		printUsage();
+
+		return 1;
+	}
+
+	size_t threadsCount = std::max(1U, std::thread::hardware_concurrency());
+	bool originalSpeed = false;
+
+	try
+	{
+		localization::MultiLocalizationManager& manager = localization::MultiLocalizationManager::getManager();
+
+		for (int i = 2; i < argc; i++)
+		{
+			if (!std::strcmp(argv[i], "--threads") && i + 1 < argc)
+			{
+				threadsCount = std::max(1, std::stoi(argv[++i]));
+			}
+			else if (!std::strcmp(argv[i], "--speed") && i + 1 < argc)
+			{
+				originalSpeed = !std::strcmp(argv[++i], "original");
+			}
+			else if (!std::strcmp(argv[i], "--module") && i + 1 < argc)
+			{
+				std::string_view module = argv[++i];
+				size_t separator = module.find('=');
+
+				manager.addModule(std::string(module.substr(0, separator)), separator == std::string_view::npos ? "" : module.substr(separator + 1));
+			}
+			else
+			{
+				printUsage();
+
+				return 1;
+			}
+		}
+
+		localization::LookupTrace trace = localization::LookupTrace::load(argv[1]);
+		std::vector<std::vector<const localization::TraceRecord*>> partitions(threadsCount);
+		std::vector<ReplayStatistics> statistics(threadsCount);
+		std::vector<std::thread> threads;
+		size_t truncated = 0;
+
+		// Records of one traced thread stay in one replay thread in original order
+		for (const localization::TraceRecord& record : trace.records)
+		{
+			// Cut strings would report false misses
+			if (record.truncated)
+			{
+				truncated++;
+
+				continue;
+			}
+
+			partitions[record.thread % threadsCount].push_back(&record);
+		}
+
+		if (truncated == trace.records.size())
+		{
+			std::cout << std::format("Trace has no replayable records\ntruncated records skipped: {}", truncated) << std::endl;
+
+			return 0;
+		}
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+		for (size_t i = 0; i < threadsCount; i++)
+		{
+			threads.emplace_back(replay, std::cref(trace), std::cref(partitions[i]), originalSpeed, start, std::ref(statistics[i]));
+		}
+
+		for (std::thread& thread : threads)
+		{
+			thread.join();
+		}
+
+		double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		ReplayStatistics total;
+
+		for (ReplayStatistics& threadStatistics : statistics)
+		{
+			total.latencies.insert(total.latencies.end(), threadStatistics.latencies.begin(), threadStatistics.latencies.end());
+			total.misses += threadStatistics.misses;
+			total.mismatches += threadStatistics.mismatches;
+		}
+
+		std::sort(total.latencies.begin(), total.latencies.end());
+
+		auto percentile = [&total](double value)
+			{
+				return total.latencies[std::min(total.latencies.size() - 1, static_cast<size_t>(value * total.latencies.size()))];
+			};
+
+		std::cout << std::format("records: {}\nthreads: {}\nspeed: {}\nelapsed: {:.3f} s\nthroughput: {:.0f} lookups/s\n", total.latencies.size(), threadsCount, originalSpeed ? "original" : "max", elapsed, total.latencies.size() / elapsed);
+		std::cout << std::format("latency ns: p50 {} p90 {} p99 {} p99.9 {} max {}\n", percentile(0.5), percentile(0.9), percentile(0.99), percentile(0.999), total.latencies.back());
+		std::cout << std::format("misses: {}\nresult mismatches: {}\ntruncated records skipped: {}", total.misses, total.mismatches, truncated) << std::endl;
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << e.what() << std::endl;
+
+		return 2;
+	}
+
+	return 0;
+}
+
+void printUsage()
+{
+	std::cerr << "Usage: localization-replay <trace> [--threads N] [--speed original|max] [--module name[=path]]..." << std::endl;
+}
+
+void replay(const localization::LookupTrace& trace, const std::vector<const localization::TraceRecord*>& records, bool originalSpeed, std::chrono::steady_clock::time_point start, ReplayStatistics& statistics)
+{
+	localization::MultiLocalizationManager& manager = localization::MultiLocalizationManager::getManager();
+	uint64_t firstTimestamp = trace.records.front().timestamp;
+
+	statistics.latencies.reserve(records.size());
+
+	for (const localization::TraceRecord* record : records)
+	{
+		if (originalSpeed)
+		{
+			std::this_thread::sleep_until(start + std::chrono::nanoseconds(record->timestamp - firstTimestamp));
+		}
+
+		bool miss = false;
+		std::chrono::steady_clock::time_point lookupStart = std::chrono::steady_clock::now();
+
+		try
+		{
+			manager.getLocalizedString(trace.strings[record->module], trace.strings[record->key], trace.strings[record->language]);
+		}
+		catch (const std::runtime_error&)
+		{
+			miss = true;
+		}
+
+		statistics.latencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - lookupStart).count());
+
+		statistics.misses += miss;
+		// Module set differs from traced one
+		statistics.mismatches += miss != (record->result == localization::LookupResult::miss);
+	}
+}